@@ -17,15 +17,19 @@ layout (location = 2) in vec3 vTan;
 layout (location = 3) in vec3 vBitan;
 layout (location = 4) in vec2 vUV;
 layout (location = 5) in vec2 vHeapMapUV;
+layout (location = 6) in mat4 instanceModelMat;     /*  per instance, when instancingOn */
 uniform mat4 mvMat;     /*  model-view matrix for positions */
 uniform mat4 nmvMat;    /*  model-view matrix for normals */
 uniform mat4 projMat;   /*  projection matrix */
+uniform mat4 viewMat;
+uniform bool instancingOn;
 
 varying vec3 iNormal; 
 varying vec2 iHeapMapUV; 
 void main() {
-    gl_Position = projMat * mvMat* vec4(vPosition,1.0); 
-    iNormal=vec3(mvMat *vec4(vNormal,0)); 
+    mat4 mv = instancingOn ? viewMat * instanceModelMat : mvMat;
+    gl_Position = projMat * mv* vec4(vPosition,1.0); 
+    iNormal=vec3(mv *vec4(vNormal,0)); 
     iNormal = normalize(iNormal);
     iHeapMapUV=vHeapMapUV;
 }
\ No newline at end of file
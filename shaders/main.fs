@@ -23,11 +23,11 @@ uniform vec4 ambient;
 uniform vec4 diffuse;
 uniform vec4 specular;
 uniform int specularPower;
-uniform vec3 uOutColor;
 /*  These could be in view space or tangent space */
 in vec3 lightDir[10];
 in vec3 viewDir;
 in vec3 normal;
+flat in vec3 objectColor;    /*  uOutColor, or the instance color */
 
 uniform bool normalMappingOn;   /*  whether normal mapping is on */
 uniform bool parallaxMappingOn; /*  whether parallax mapping is on */
@@ -92,7 +92,7 @@ void main(void)
     }
     else
     {
-        outColor = vec4(uOutColor,1); /*  Use texture for color */
+        outColor = vec4(objectColor,1); /*  Use texture for color */
     }
     //fragColor = vec4(norm, 1);
 }
\ No newline at end of file
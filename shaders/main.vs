@@ -17,9 +17,17 @@ layout (location = 2) in vec3 tan;
 layout (location = 3) in vec3 bitan;
 layout (location = 4) in vec2 uv;
 
+/*  Per instance attributes, only read when instancingOn */
+layout (location = 6) in mat4 instanceModelMat;     /*  model-world matrix */
+layout (location = 10) in mat3 instanceNormalMat;   /*  its inverse transpose */
+layout (location = 13) in vec3 instanceColor;
+
 uniform mat4 mvMat;     /*  model-view matrix for positions */
 uniform mat4 nmvMat;    /*  model-view matrix for normals */
 uniform mat4 projMat;   /*  projection matrix */
+uniform mat4 viewMat;   /*  view matrix, for instanced draws */
+uniform bool instancingOn;
+uniform vec3 uOutColor;
 
 uniform bool lightOn;           /*  whether lighting should be applied */
 uniform int  numLights;
@@ -37,11 +45,17 @@ out vec2 uvCoord;
 out vec3 lightDir[10];
 out vec3 viewDir;
 out vec3 normal;
+flat out vec3 objectColor;
 
 
 void main(void) 
 {
-    vec4 posVF = mvMat * vec4(pos, 1.0);
+    /*  instances carry their own transform, the view is shared */
+    mat4 mv = instancingOn ? viewMat * instanceModelMat : mvMat;
+    mat3 nmv = instancingOn ? mat3(viewMat) * instanceNormalMat : mat3(nmvMat);
+    objectColor = instancingOn ? instanceColor : uOutColor;
+
+    vec4 posVF = mv * vec4(pos, 1.0);
 
 
     /*  For object texturing */
@@ -56,7 +70,7 @@ void main(void)
 		/*view direction*/
 		viewDir = -posVF.xyz; 
 		/*normal*/
-		normal = normalize(mat3(nmvMat) * nrm);  
+		normal = normalize(nmv * nrm);  
 		/*lights*/       
         for (int i = 0; i < numLights; ++i)
           lightDir[i] = normalize(lightPosVF[i] - posVF.xyz); 
@@ -70,8 +84,8 @@ void main(void)
                 from the normal texture in the fragment shader.
             */
             /*  ... */
-			vec3 tangentVF		= vec3(normalize(mat3(mvMat) * tan));
-            vec3 bitangentVF	= vec3(normalize(mat3(mvMat) * bitan));
+			vec3 tangentVF		= vec3(normalize(mat3(mv) * tan));
+            vec3 bitangentVF	= vec3(normalize(mat3(mv) * bitan));
             mat3 transpose		= transpose(mat3(tangentVF, bitangentVF, normal));
             viewDir = transpose * (-posVF.xyz);               
             for (int i = 0; i < numLights; ++i)
@@ -192,16 +192,16 @@ namespace Proto
 
     /*************************************************************************/
     /*!
-    \fn void AABB::Create(VertexBufferType & t_ModelVertexList)
+    \fn void AABB::Create(const PositionBufferType & t_ModelVertexList)
 
     \brief
         This function creates the AABB.
 
     \param t_ModelVertexList
-        This is the object model vertex list.
+        This is the object model vertex position list.
     */
     /*************************************************************************/
-    void AABB::Create(const VertexBufferType & t_ModelVertexList)
+    void AABB::Create(const PositionBufferType & t_ModelVertexList)
     {
         //vec3 g_Min = vec3( FLT_MAX ,  FLT_MAX , -FLT_MAX);
         vec3 g_Min = vec3( FLT_MAX ,  FLT_MAX , FLT_MAX);
@@ -211,10 +211,10 @@ namespace Proto
         u32 t_Size = t_ModelVertexList.size();
         for(u32 i = 0; i < t_Size; ++i)
         {
-            Vertex t_NewVertex  = t_ModelVertexList[i];
-            f32 t_PosX          = t_NewVertex.pos.x;
-            f32 t_PosY          = t_NewVertex.pos.y;
-            f32 t_PosZ          = t_NewVertex.pos.z;
+            const vec3& t_NewVertex = t_ModelVertexList[i];
+            f32 t_PosX          = t_NewVertex.x;
+            f32 t_PosY          = t_NewVertex.y;
+            f32 t_PosZ          = t_NewVertex.z;
 
             // Update lower-left-front corner of BB
             g_Min.x = std::min(g_Min.x, t_PosX);
@@ -233,20 +233,25 @@ namespace Proto
         ComputeCenterRadius(g_Min, g_Max);
     }
 
-	void AABB::Create(const VertexBufferType & t_ModelVertexList, const std::vector<int>& indicies)
+	void AABB::Create(const PositionBufferType & t_ModelVertexList, const std::vector<int>& indicies)
+	{
+		Create(t_ModelVertexList, indicies.empty() ? nullptr : &indicies[0], indicies.size());
+	}
+
+	void AABB::Create(const PositionBufferType & t_ModelVertexList, const int * indicies, u32 count)
 	{
 		//vec3 g_Min = vec3( FLT_MAX ,  FLT_MAX , -FLT_MAX);
 		vec3 g_Min = vec3(FLT_MAX, FLT_MAX, FLT_MAX);
 		//vec3 g_Max = vec3(-FLT_MAX , -FLT_MAX ,  FLT_MAX);
 		vec3 g_Max = vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
 
-		u32 t_Size = indicies.size();
+		u32 t_Size = count;
 		for (u32 i = 0; i < t_Size; ++i)
 		{
-			Vertex t_NewVertex = t_ModelVertexList[indicies[i]];
-			f32 t_PosX = t_NewVertex.pos.x;
-			f32 t_PosY = t_NewVertex.pos.y;
-			f32 t_PosZ = t_NewVertex.pos.z;
+			const vec3& t_NewVertex = t_ModelVertexList[indicies[i]];
+			f32 t_PosX = t_NewVertex.x;
+			f32 t_PosY = t_NewVertex.y;
+			f32 t_PosZ = t_NewVertex.z;
 
 			// Update lower-left-front corner of BB
 			g_Min.x = std::min(g_Min.x, t_PosX);
@@ -265,7 +270,7 @@ namespace Proto
 		ComputeCenterRadius(g_Min, g_Max);
 	}
 
-	void AABB::Create(const mat4&transform, const VertexBufferType & t_ModelVertexList)
+	void AABB::Create(const mat4&transform, const PositionBufferType & t_ModelVertexList)
 	{
 		//vec3 g_Min = vec3( FLT_MAX ,  FLT_MAX , -FLT_MAX);
 		vec3 g_Min = vec3(FLT_MAX, FLT_MAX, FLT_MAX);
@@ -275,8 +280,8 @@ namespace Proto
 		u32 t_Size = t_ModelVertexList.size();
 		for (u32 i = 0; i < t_Size; ++i)
 		{
-			Vertex t_NewVertex = t_ModelVertexList[i];
-			vec3 pt = vec3(transform * vec4(t_NewVertex.pos,1));
+			const vec3& t_NewVertex = t_ModelVertexList[i];
+			vec3 pt = vec3(transform * vec4(t_NewVertex,1));
 			f32 t_PosX = pt.x;
 			f32 t_PosY = pt.y;
 			f32 t_PosZ = pt.z;
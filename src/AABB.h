@@ -49,10 +49,11 @@ namespace Proto
 			void SetMax(u32 axisID, f32 position);
 			void SetMin(u32 axisID, f32 position);
 
-            void            Create(const VertexBufferType & t_ModelVertexList);
+            void            Create(const PositionBufferType & t_ModelVertexList);
 
-			void            Create(const VertexBufferType & t_ModelVertexList,const  std::vector<int>& indicies);
-			void            Create(const mat4& transform, const VertexBufferType & t_ModelVertexList);
+			void            Create(const PositionBufferType & t_ModelVertexList,const  std::vector<int>& indicies);
+			void            Create(const PositionBufferType & t_ModelVertexList, const int * indicies, u32 count);
+			void            Create(const mat4& transform, const PositionBufferType & t_ModelVertexList);
             void            ComputeCenterRadius(const vec3 & t_Min,
                                                 const vec3 & t_Max);
             
@@ -0,0 +1,94 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      AllocationCounter.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+#include "AllocationCounter.h"
+
+#if TRACK_ALLOCATIONS
+
+// zero initialised before any constructor runs, so allocations made during
+// static initialisation are counted too
+static std::atomic<u32> s_AllocationCount;
+
+static void * CountedAllocate(size_t t_Size)
+{
+    s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(t_Size ? t_Size : 1);
+}
+
+void * operator new(size_t t_Size)
+{
+    void * t_Memory = CountedAllocate(t_Size);
+    if (!t_Memory)
+        throw std::bad_alloc();
+    return t_Memory;
+}
+
+void * operator new[](size_t t_Size)
+{
+    void * t_Memory = CountedAllocate(t_Size);
+    if (!t_Memory)
+        throw std::bad_alloc();
+    return t_Memory;
+}
+
+void * operator new(size_t t_Size, const std::nothrow_t &) throw()
+{
+    return CountedAllocate(t_Size);
+}
+
+void * operator new[](size_t t_Size, const std::nothrow_t &) throw()
+{
+    return CountedAllocate(t_Size);
+}
+
+void operator delete(void * t_Memory) throw()
+{
+    std::free(t_Memory);
+}
+
+void operator delete[](void * t_Memory) throw()
+{
+    std::free(t_Memory);
+}
+
+// sized forms, used by compilers with C++14 sized deallocation
+void operator delete(void * t_Memory, size_t) throw()
+{
+    std::free(t_Memory);
+}
+
+void operator delete[](void * t_Memory, size_t) throw()
+{
+    std::free(t_Memory);
+}
+
+void operator delete(void * t_Memory, const std::nothrow_t &) throw()
+{
+    std::free(t_Memory);
+}
+
+void operator delete[](void * t_Memory, const std::nothrow_t &) throw()
+{
+    std::free(t_Memory);
+}
+
+#endif
+
+namespace Proto
+{
+    u32 GetAllocationCount()
+    {
+#if TRACK_ALLOCATIONS
+        return s_AllocationCount.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,28 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      AllocationCounter.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _ALLOCATIONCOUNTER_H_
+#define _ALLOCATIONCOUNTER_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Defines.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Number of operator new calls made so far by any thread of the 
+    // program, 0 when TRACK_ALLOCATIONS is off. The difference across a 
+    // frame is shown on the tweak bar and should stay 0 once warmed up.
+    u32     GetAllocationCount();
+}
+
+#endif
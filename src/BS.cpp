@@ -49,7 +49,7 @@ namespace Proto
     /*************************************************************************/
     /*!
     \fn void BS::RitterSphere(BS &                  t_BS, 
-                              VertexBufferType &    t_VertCont, 
+                              const PositionBufferType & t_VertCont, 
                               int                   t_NoOfPoints)
 
     \brief
@@ -66,7 +66,7 @@ namespace Proto
     */
     /*************************************************************************/
     void BS::RitterSphere(BS &                  t_BS, 
-                          VertexBufferType &    t_VertCont, 
+                          const PositionBufferType & t_VertCont, 
                           int                   t_NoOfPoints)
     {
         // Get sphere encompassing two approximately most distant points
@@ -81,7 +81,7 @@ namespace Proto
 
 
 	void  BS::RitterSphere(
-		const VertexBufferType & t_VertCont,
+		const PositionBufferType & t_VertCont,
 		const std::vector<int>&   indices)
 	{
 		// Get sphere encompassing two approximately most distant points
@@ -96,7 +96,7 @@ namespace Proto
     /*************************************************************************/
     /*!
     \fn void BS::SphereFromDistantPoints(BS &               t_BS, 
-                                         VertexBufferType & t_VertCont, 
+                                         PositionBufferType & t_VertCont, 
                                          int                t_NoOfPoints)
 
     \brief
@@ -114,7 +114,7 @@ namespace Proto
     */
     /*************************************************************************/
     void BS::SphereFromDistantPoints(BS &       t_BS, 
-                                     const VertexBufferType & t_VertCont, 
+                                     const PositionBufferType & t_VertCont, 
                                      int        t_NoOfPoints)
     {
         // Find the most separated point pair defining the encompassing AABB
@@ -123,16 +123,16 @@ namespace Proto
         MostSeparatedPointsOnAABB(min, max, t_VertCont, t_NoOfPoints);
 
         // Set up sphere to just encompass these two points
-        Vertex t_MinPt   = t_VertCont[min];
-        Vertex t_MaxPt   = t_VertCont[max];
+        vec3 t_MinPt   = t_VertCont[min];
+        vec3 t_MaxPt   = t_VertCont[max];
 
-        t_BS.m_Center = (t_MinPt.pos + t_MaxPt.pos) * 0.5f;
-        vec3 t_RadVec = t_MaxPt.pos - t_BS.m_Center;
+        t_BS.m_Center = (t_MinPt + t_MaxPt) * 0.5f;
+        vec3 t_RadVec = t_MaxPt - t_BS.m_Center;
         t_BS.m_Radius   = glm::sqrt(glm::dot(t_RadVec, t_RadVec));
     }
 
 	void BS::SphereFromDistantPoints(BS &       t_BS,
-		const VertexBufferType & t_VertCont,
+		const PositionBufferType & t_VertCont,
 		const std::vector<int>&indicies)
 	{
 		// Find the most separated point pair defining the encompassing AABB
@@ -141,17 +141,17 @@ namespace Proto
 		MostSeparatedPointsOnAABB(min, max, t_VertCont, indicies);
 
 		// Set up sphere to just encompass these two points
-		Vertex t_MinPt = t_VertCont[min];
-		Vertex t_MaxPt = t_VertCont[max];
+		vec3 t_MinPt = t_VertCont[min];
+		vec3 t_MaxPt = t_VertCont[max];
 
-		t_BS.m_Center = (t_MinPt.pos + t_MaxPt.pos) * 0.5f;
-		vec3 t_RadVec = t_MaxPt.pos - t_BS.m_Center;
+		t_BS.m_Center = (t_MinPt + t_MaxPt) * 0.5f;
+		vec3 t_RadVec = t_MaxPt - t_BS.m_Center;
 		t_BS.m_Radius = glm::sqrt(glm::dot(t_RadVec, t_RadVec));
 	}
 
     /*************************************************************************/
     /*!
-    \fn void BS::SphereOfSphereAndPt(BS & t_BS, Vertex & t_Vertex)
+    \fn void BS::SphereOfSphereAndPt(BS & t_BS, const vec3 & t_Point)
 
     \brief
         This function grows sphere to include all points
@@ -159,14 +159,14 @@ namespace Proto
     \param t_BS
         This is the object's bounding sphere.
 
-    \param t_Vertex
-        This is the vertex to be included into the sphere.
+    \param t_Point
+        This is the vertex position to be included into the sphere.
     */
     /*************************************************************************/
-    void BS::SphereOfSphereAndPt(BS & t_BS, const Vertex & t_Vertex)
+    void BS::SphereOfSphereAndPt(BS & t_BS, const vec3 & t_Point)
     {
         // Compute squared distance between point and sphere center
-        vec3 d      = t_Vertex.pos - t_BS.m_Center;
+        vec3 d      = t_Point - t_BS.m_Center;
         f32 dist2   = glm::dot(d, d);
 
         // Only update s if point p is outside it
@@ -185,7 +185,7 @@ namespace Proto
     /**********************************************************************************************//**
      * \fn  void BS::MostSeparatedPointsOnAABB(int & t_Min, 
      * 		                                   int & t_Max,
-     *                                         VertexBufferType & t_VertCont, 
+     *                                         PositionBufferType & t_VertCont, 
      *                                         int t_NoOfPoints)
      *
      * \brief   Most separated point pair defining the encompassing AABB.
@@ -199,7 +199,7 @@ namespace Proto
      **************************************************************************************************/
     void BS::MostSeparatedPointsOnAABB(int &                t_Min, 
                                        int &                t_Max, 
-                                       const VertexBufferType &   t_VertCont, 
+                                       const PositionBufferType & t_VertCont, 
                                        int                  t_NoOfPoints)
     {
         // First find most extreme points along principal axes
@@ -209,31 +209,31 @@ namespace Proto
 		if (t_NoOfPoints == 0) return;
         for(int i = 1; i < t_NoOfPoints; ++i) 
         {
-            vec3 t_CurrPt = t_VertCont[i].pos;
+            vec3 t_CurrPt = t_VertCont[i];
 
-            if (t_CurrPt.x < t_VertCont[minx].pos.x)
+            if (t_CurrPt.x < t_VertCont[minx].x)
                 minx = i;
 
-            if (t_CurrPt.x > t_VertCont[maxx].pos.x)
+            if (t_CurrPt.x > t_VertCont[maxx].x)
                 maxx = i;
 
-            if (t_CurrPt.y < t_VertCont[miny].pos.y)
+            if (t_CurrPt.y < t_VertCont[miny].y)
                 miny = i;
 
-            if (t_CurrPt.y > t_VertCont[maxy].pos.y)
+            if (t_CurrPt.y > t_VertCont[maxy].y)
                 maxy = i;
 
-            if (t_CurrPt.z < t_VertCont[minz].pos.z)
+            if (t_CurrPt.z < t_VertCont[minz].z)
                 minz = i;
 
-            if (t_CurrPt.z > t_VertCont[maxz].pos.z)
+            if (t_CurrPt.z > t_VertCont[maxz].z)
                 maxz = i;
         }
 
         // Compute the squared distances for the three pairs of points
-        vec3 t_DiffX = t_VertCont[maxx].pos - t_VertCont[minx].pos;
-        vec3 t_DiffY = t_VertCont[maxy].pos - t_VertCont[miny].pos;
-        vec3 t_DiffZ = t_VertCont[maxz].pos - t_VertCont[minz].pos;
+        vec3 t_DiffX = t_VertCont[maxx] - t_VertCont[minx];
+        vec3 t_DiffY = t_VertCont[maxy] - t_VertCont[miny];
+        vec3 t_DiffZ = t_VertCont[maxz] - t_VertCont[minz];
 
         f32 dist2x = glm::dot(t_DiffX, t_DiffX);
         f32 dist2y = glm::dot(t_DiffY, t_DiffY);
@@ -259,7 +259,7 @@ namespace Proto
 
 	void BS::MostSeparatedPointsOnAABB(int &                t_Min,
 		int &                t_Max,
-		const VertexBufferType &   t_VertCont,
+		const PositionBufferType & t_VertCont,
 		const std::vector<int>&indicies)
 	{
 		// First find most extreme points along principal axes
@@ -270,31 +270,31 @@ namespace Proto
 		if (indicies.size() == 0) return;
 		for (int i = 1; i < t_NoOfPoints; ++i)
 		{
-			vec3 t_CurrPt = t_VertCont[indicies[i]].pos;
+			vec3 t_CurrPt = t_VertCont[indicies[i]];
 
-			if (t_CurrPt.x < t_VertCont[minx].pos.x)
+			if (t_CurrPt.x < t_VertCont[minx].x)
 				minx = indicies[i];
 
-			if (t_CurrPt.x > t_VertCont[maxx].pos.x)
+			if (t_CurrPt.x > t_VertCont[maxx].x)
 				maxx = indicies[i];
 
-			if (t_CurrPt.y < t_VertCont[miny].pos.y)
+			if (t_CurrPt.y < t_VertCont[miny].y)
 				miny = indicies[i];
 
-			if (t_CurrPt.y > t_VertCont[maxy].pos.y)
+			if (t_CurrPt.y > t_VertCont[maxy].y)
 				maxy = indicies[i];
 
-			if (t_CurrPt.z < t_VertCont[minz].pos.z)
+			if (t_CurrPt.z < t_VertCont[minz].z)
 				minz = indicies[i];
 
-			if (t_CurrPt.z > t_VertCont[maxz].pos.z)
+			if (t_CurrPt.z > t_VertCont[maxz].z)
 				maxz = indicies[i];
 		}
 
 		// Compute the squared distances for the three pairs of points
-		vec3 t_DiffX = t_VertCont[maxx].pos - t_VertCont[minx].pos;
-		vec3 t_DiffY = t_VertCont[maxy].pos - t_VertCont[miny].pos;
-		vec3 t_DiffZ = t_VertCont[maxz].pos - t_VertCont[minz].pos;
+		vec3 t_DiffX = t_VertCont[maxx] - t_VertCont[minx];
+		vec3 t_DiffY = t_VertCont[maxy] - t_VertCont[miny];
+		vec3 t_DiffZ = t_VertCont[maxz] - t_VertCont[minz];
 
 		f32 dist2x = glm::dot(t_DiffX, t_DiffX);
 		f32 dist2y = glm::dot(t_DiffY, t_DiffY);
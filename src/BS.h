@@ -45,12 +45,12 @@ namespace Proto
                                      const vec3 & t_RotVec, 
                                      const BS   & t_InBS);
             
-            void            RitterSphere(BS &               t_BS, 
-                                         VertexBufferType & t_VertCont, 
-                                         int                t_NoOfPoints);
+            void            RitterSphere(BS &                       t_BS, 
+                                         const PositionBufferType & t_VertCont, 
+                                         int                        t_NoOfPoints);
 
 			void            RitterSphere(
-										const VertexBufferType & t_VertCont,
+										const PositionBufferType & t_VertCont,
 										const std::vector<int>&   indices);
             
         //private:
@@ -58,24 +58,24 @@ namespace Proto
             f32             m_Radius;
             vec3            m_Center;
             void            SphereFromDistantPoints(BS &                t_BS, 
-                                                    const VertexBufferType &  t_VertCont, 
+                                                    const PositionBufferType &  t_VertCont, 
                                                     int                 t_NoOfPoints);
 			void            SphereFromDistantPoints(BS &                t_BS,
-				const VertexBufferType &  t_VertCont,
+				const PositionBufferType &  t_VertCont,
 				const std::vector<int>&   indices);
 
 
-            void            SphereOfSphereAndPt(BS      & t_BS, 
-                                                const Vertex  & t_Vertex);
+            void            SphereOfSphereAndPt(BS          & t_BS, 
+                                                const vec3  & t_Point);
 
             void            MostSeparatedPointsOnAABB(int &                 min, 
                                                       int &                 max, 
-                                                      const VertexBufferType &    t_VertCont, 
+                                                      const PositionBufferType &  t_VertCont, 
                                                       int                   t_NoOfPoints);
 
 			void            MostSeparatedPointsOnAABB(int &                 min,
 				int &                 max,
-				const VertexBufferType &    t_VertCont,
+				const PositionBufferType &  t_VertCont,
 				const std::vector<int>&   indices);
     };
 }
@@ -0,0 +1,469 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      BVHSceneGraph.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <algorithm>
+#include "BVHSceneGraph.h"
+#include "SceneObject.h"
+#include "Collision.h"
+
+namespace
+{
+	Proto::AABB Union(const Proto::AABB& a, const Proto::AABB& b)
+	{
+		Proto::AABB result;
+		result.ComputeCenterRadius(glm::min(a.GetMinVertex(), b.GetMinVertex()),
+		                           glm::max(a.GetMaxVertex(), b.GetMaxVertex()));
+		return result;
+	}
+
+	f32 SurfaceArea(const Proto::AABB& box)
+	{
+		const vec3& r = box.m_Radius;
+		return 8.f * (r.x * r.y + r.y * r.z + r.z * r.x);
+	}
+
+	bool Contains(const Proto::AABB& outer, const Proto::AABB& inner)
+	{
+		for (u32 i = 0; i < 3; ++i)
+		{
+			if (fabs(inner.m_Center[i] - outer.m_Center[i]) + inner.m_Radius[i] > outer.m_Radius[i])
+				return false;
+		}
+		return true;
+	}
+}
+
+BVHSceneGraph::BVHSceneGraph()
+	: m_Root(-1)
+	, m_FreeList(-1)
+{
+}
+
+
+
+BVHSceneGraph::~BVHSceneGraph()
+{
+}
+
+
+
+Proto::SceneObject* BVHSceneGraph::GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection)
+{
+	return Query(origin, ray, FLT_MAX, false, timeOfIntersection);
+}
+
+
+
+Proto::SceneObject* BVHSceneGraph::GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection)
+{
+	return Query(origin, ray, lightDistance, true, timeOfIntersection);
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn void BVHSceneGraph::InsertObject(Proto::SceneObject* object)
+
+\brief
+	Adds a leaf for the object, fitted to its current world box. An object
+	already in the graph is only updated.
+*/
+/*************************************************************************/
+void BVHSceneGraph::InsertObject(Proto::SceneObject* object)
+{
+	if (m_Leaves.count(object))
+	{
+		UpdateObject(object);
+		return;
+	}
+
+	s32 leaf = AllocateNode();
+	m_Nodes[leaf].m_Object = object;
+	FitLeaf(leaf);
+	InsertLeaf(leaf);
+	m_Leaves[object] = leaf;
+}
+
+
+
+void BVHSceneGraph::RemoveObject(Proto::SceneObject* object)
+{
+	std::unordered_map<Proto::SceneObject*, s32>::iterator it = m_Leaves.find(object);
+	if (it == m_Leaves.end())
+		return;
+
+	RemoveLeaf(it->second);
+	FreeNode(it->second);
+	m_Leaves.erase(it);
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn void BVHSceneGraph::UpdateObject(Proto::SceneObject* object)
+
+\brief
+	Refreshes the object's transform. The tree is only restructured once
+	the world box has left the enlarged leaf box.
+*/
+/*************************************************************************/
+void BVHSceneGraph::UpdateObject(Proto::SceneObject* object)
+{
+	std::unordered_map<Proto::SceneObject*, s32>::iterator it = m_Leaves.find(object);
+	if (it == m_Leaves.end())
+		return;
+
+	s32 leaf = it->second;
+	Node& node = m_Nodes[leaf];
+	node.m_WorldToModel = Inverse(object->GetMWMatrix());
+	if (Contains(node.m_Box, object->GetMeshRenderer()->GetWorldSpaceAABB()))
+		return;
+
+	RemoveLeaf(leaf);
+	FitLeaf(leaf);
+	InsertLeaf(leaf);
+}
+
+
+
+void BVHSceneGraph::Clear()
+{
+	m_Nodes.clear();
+	m_Leaves.clear();
+	m_Root = -1;
+	m_FreeList = -1;
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn void BVHSceneGraph::CollectInFrustum(const Proto::Frustum& frustum,
+                                         std::vector<Proto::SceneObject*>& objects) const
+
+\brief
+	Walks the tree from the root, dropping every subtree whose box is
+	outside the frustum. A subtree entirely inside is taken whole without
+	any further plane test. Leaves that still straddle a plane are tested
+	with the object's own world box rather than the enlarged leaf box.
+*/
+/*************************************************************************/
+void BVHSceneGraph::CollectInFrustum(const Proto::Frustum& frustum, std::vector<Proto::SceneObject*>& objects) const
+{
+	if (m_Root == -1)
+		return;
+
+	s32 stack[64];
+	u32 masks[64];
+	s32 top = 0;
+	stack[top] = m_Root;
+	masks[top++] = FRUSTUM_ALL_PLANES;
+	while (top > 0)
+	{
+		--top;
+		const Node& node = m_Nodes[stack[top]];
+		u32 mask = masks[top];
+		if (mask && frustum.Classify(node.m_Box, mask) == Proto::FrustumTest::OUTSIDE)
+			continue;
+
+		if (node.m_Left != -1)
+		{
+			stack[top] = node.m_Left;
+			masks[top++] = mask;
+			stack[top] = node.m_Right;
+			masks[top++] = mask;
+			continue;
+		}
+
+		if (mask && frustum.Classify(node.m_Object->GetMeshRenderer()->GetWorldSpaceAABB(), mask) == Proto::FrustumTest::OUTSIDE)
+			continue;
+		objects.push_back(node.m_Object);
+	}
+}
+
+
+
+s32 BVHSceneGraph::AllocateNode()
+{
+	s32 index = m_FreeList;
+	if (index == -1)
+	{
+		index = m_Nodes.size();
+		m_Nodes.push_back(Node());
+	}
+	else
+	{
+		m_FreeList = m_Nodes[index].m_Parent;
+	}
+
+	Node& node = m_Nodes[index];
+	node.m_Parent = -1;
+	node.m_Left = -1;
+	node.m_Right = -1;
+	node.m_Height = 0;
+	node.m_Object = nullptr;
+	return index;
+}
+
+
+
+void BVHSceneGraph::FreeNode(s32 index)
+{
+	m_Nodes[index].m_Parent = m_FreeList;
+	m_Nodes[index].m_Height = -1;
+	m_Nodes[index].m_Object = nullptr;
+	m_FreeList = index;
+}
+
+
+
+void BVHSceneGraph::FitLeaf(s32 leaf)
+{
+	Node& node = m_Nodes[leaf];
+	node.m_Box = node.m_Object->GetMeshRenderer()->GetWorldSpaceAABB();
+	node.m_Box.m_Radius += node.m_Box.m_Radius * BVH_SCENE_GRAPH_MARGIN;
+	node.m_WorldToModel = Inverse(node.m_Object->GetMWMatrix());
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn void BVHSceneGraph::InsertLeaf(s32 leaf)
+
+\brief
+	Descends towards the sibling whose pairing with the leaf adds the least
+	surface area to the tree, then rebalances on the way back up.
+*/
+/*************************************************************************/
+void BVHSceneGraph::InsertLeaf(s32 leaf)
+{
+	if (m_Root == -1)
+	{
+		m_Root = leaf;
+		m_Nodes[leaf].m_Parent = -1;
+		return;
+	}
+
+	Proto::AABB leafBox = m_Nodes[leaf].m_Box;
+	s32 index = m_Root;
+	while (m_Nodes[index].m_Left != -1)
+	{
+		const Node& node = m_Nodes[index];
+		f32 area = SurfaceArea(node.m_Box);
+		f32 combinedArea = SurfaceArea(Union(node.m_Box, leafBox));
+
+		//cost of pairing with this node, and the growth every ancestor of a
+		//deeper sibling pays anyway
+		f32 cost = 2.f * combinedArea;
+		f32 inheritance = 2.f * (combinedArea - area);
+
+		f32 childCost[2];
+		s32 children[2] = { node.m_Left, node.m_Right };
+		for (u32 i = 0; i < 2; ++i)
+		{
+			const Node& child = m_Nodes[children[i]];
+			childCost[i] = SurfaceArea(Union(child.m_Box, leafBox)) + inheritance;
+			if (child.m_Left != -1)
+				childCost[i] -= SurfaceArea(child.m_Box);
+		}
+
+		if (cost < childCost[0] && cost < childCost[1])
+			break;
+		index = (childCost[0] < childCost[1]) ? children[0] : children[1];
+	}
+
+	s32 sibling = index;
+	s32 oldParent = m_Nodes[sibling].m_Parent;
+	s32 newParent = AllocateNode();
+
+	Node& parent = m_Nodes[newParent];
+	parent.m_Parent = oldParent;
+	parent.m_Left = sibling;
+	parent.m_Right = leaf;
+	parent.m_Box = Union(leafBox, m_Nodes[sibling].m_Box);
+	parent.m_Height = m_Nodes[sibling].m_Height + 1;
+
+	if (oldParent == -1)
+		m_Root = newParent;
+	else if (m_Nodes[oldParent].m_Left == sibling)
+		m_Nodes[oldParent].m_Left = newParent;
+	else
+		m_Nodes[oldParent].m_Right = newParent;
+
+	m_Nodes[sibling].m_Parent = newParent;
+	m_Nodes[leaf].m_Parent = newParent;
+
+	Refit(oldParent);
+}
+
+
+
+void BVHSceneGraph::RemoveLeaf(s32 leaf)
+{
+	if (leaf == m_Root)
+	{
+		m_Root = -1;
+		return;
+	}
+
+	s32 parent = m_Nodes[leaf].m_Parent;
+	s32 grandParent = m_Nodes[parent].m_Parent;
+	s32 sibling = (m_Nodes[parent].m_Left == leaf) ? m_Nodes[parent].m_Right : m_Nodes[parent].m_Left;
+
+	m_Nodes[sibling].m_Parent = grandParent;
+	if (grandParent == -1)
+		m_Root = sibling;
+	else if (m_Nodes[grandParent].m_Left == parent)
+		m_Nodes[grandParent].m_Left = sibling;
+	else
+		m_Nodes[grandParent].m_Right = sibling;
+
+	FreeNode(parent);
+	Refit(grandParent);
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn s32 BVHSceneGraph::Balance(s32 index)
+
+\brief
+	Rotates the taller grandchild up when the heights of the node's
+	children differ by more than one.
+
+\return
+	The node now at the top of the subtree.
+*/
+/*************************************************************************/
+s32 BVHSceneGraph::Balance(s32 index)
+{
+	Node& a = m_Nodes[index];
+	if (a.m_Left == -1 || a.m_Height < 2)
+		return index;
+
+	s32 b = a.m_Left;
+	s32 c = a.m_Right;
+	s32 balance = m_Nodes[c].m_Height - m_Nodes[b].m_Height;
+	if (balance >= -1 && balance <= 1)
+		return index;
+
+	//the taller child takes the node's place, the node keeps the shorter
+	//child and the shorter of the taller child's children
+	s32 up = (balance > 0) ? c : b;
+	s32 other = (balance > 0) ? b : c;
+	Node& u = m_Nodes[up];
+	s32 tall = u.m_Left;
+	s32 shortChild = u.m_Right;
+	if (m_Nodes[tall].m_Height < m_Nodes[shortChild].m_Height)
+		std::swap(tall, shortChild);
+
+	u.m_Parent = a.m_Parent;
+	a.m_Parent = up;
+	if (u.m_Parent == -1)
+		m_Root = up;
+	else if (m_Nodes[u.m_Parent].m_Left == index)
+		m_Nodes[u.m_Parent].m_Left = up;
+	else
+		m_Nodes[u.m_Parent].m_Right = up;
+
+	u.m_Left = index;
+	u.m_Right = tall;
+	a.m_Left = other;
+	a.m_Right = shortChild;
+	m_Nodes[shortChild].m_Parent = index;
+
+	a.m_Box = Union(m_Nodes[other].m_Box, m_Nodes[shortChild].m_Box);
+	a.m_Height = 1 + std::max(m_Nodes[other].m_Height, m_Nodes[shortChild].m_Height);
+	u.m_Box = Union(a.m_Box, m_Nodes[tall].m_Box);
+	u.m_Height = 1 + std::max(a.m_Height, m_Nodes[tall].m_Height);
+	return up;
+}
+
+
+
+void BVHSceneGraph::Refit(s32 index)
+{
+	while (index != -1)
+	{
+		index = Balance(index);
+
+		Node& node = m_Nodes[index];
+		const Node& left = m_Nodes[node.m_Left];
+		const Node& right = m_Nodes[node.m_Right];
+		node.m_Height = 1 + std::max(left.m_Height, right.m_Height);
+		node.m_Box = Union(left.m_Box, right.m_Box);
+
+		index = node.m_Parent;
+	}
+}
+
+
+
+/*************************************************************************/
+/*!
+\fn Proto::SceneObject* BVHSceneGraph::Query(const vec3& origin,
+                                             const vec3& ray, f32 maxTime,
+                                             bool anyHit,
+                                             f32& timeOfIntersection) const
+
+\brief
+	Walks the tree along the ray, skipping every box it enters after the
+	best hit so far. The nearer child is opened first so that the best
+	hit shrinks early.
+
+\param anyHit
+	Returns the first object hit before maxTime instead of the closest.
+
+\return
+	The object hit, nullptr if none.
+*/
+/*************************************************************************/
+Proto::SceneObject* BVHSceneGraph::Query(const vec3& origin, const vec3& ray, f32 maxTime, bool anyHit, f32& timeOfIntersection) const
+{
+	if (m_Root == -1)
+		return nullptr;
+
+	Proto::SceneObject* hitObject(nullptr);
+	f32 bestTime(maxTime);
+
+	//the tree is balanced, 64 levels is far more than any scene needs
+	s32 stack[64];
+	s32 top = 0;
+	stack[top++] = m_Root;
+	while (top > 0)
+	{
+		const Node& node = m_Nodes[stack[--top]];
+		if (!Proto::IntersectLineAABB(origin, ray, node.m_Box, 0.f, bestTime))
+			continue;
+
+		if (node.m_Left != -1)
+		{
+			f32 left = Dot(m_Nodes[node.m_Left].m_Box.m_Center - origin, ray);
+			f32 right = Dot(m_Nodes[node.m_Right].m_Box.m_Center - origin, ray);
+			stack[top++] = (left < right) ? node.m_Right : node.m_Left;
+			stack[top++] = (left < right) ? node.m_Left : node.m_Right;
+			continue;
+		}
+
+		Proto::Model* model = node.m_Object->GetMeshRenderer()->GetModel();
+		f32 t;
+		if (model && Proto::IntersectRayModel(*model, node.m_WorldToModel, origin, ray, bestTime, anyHit, t))
+		{
+			bestTime = t;
+			hitObject = node.m_Object;
+			if (anyHit)
+				break;
+		}
+	}
+
+	if (hitObject)
+		timeOfIntersection = bestTime;
+	return hitObject;
+}
@@ -0,0 +1,75 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      BVHSceneGraph.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _BVHSCENEGRAPH_H_
+#define _BVHSCENEGRAPH_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <vector>
+#include <unordered_map>
+#include "ISceneGraph.h"
+#include "AABB.h"
+#include "Frustum.h"
+
+#define BVH_SCENE_GRAPH_MARGIN 0.1f     // leaf boxes are enlarged by this fraction of their size
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+// Scene graph over a dynamic AABB tree of the objects' world boxes.
+// Objects are inserted where they enlarge the tree the least and the tree
+// is kept balanced with rotations, so queries visit O(log n) objects. Leaf
+// boxes are enlarged, an object that moves within its box only refreshes
+// its world to model transform. The triangles of the objects reached are
+// tested through their model's own AABB tree.
+class BVHSceneGraph : public ISceneGraph
+{
+public:
+	BVHSceneGraph();
+	virtual ~BVHSceneGraph();
+	virtual Proto::SceneObject* GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection);
+	virtual Proto::SceneObject* GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection);
+	virtual void InsertObject(Proto::SceneObject* object);
+	virtual void RemoveObject(Proto::SceneObject* object);
+	virtual void UpdateObject(Proto::SceneObject* object);
+	void Clear();
+
+	// appends every object whose world box touches the frustum
+	void CollectInFrustum(const Proto::Frustum& frustum, std::vector<Proto::SceneObject*>& objects) const;
+
+private:
+	struct Node
+	{
+		Proto::AABB             m_Box;
+		s32                     m_Parent;       // next free node while on the free list
+		s32                     m_Left;         // -1 for leaves
+		s32                     m_Right;
+		s32                     m_Height;       // 0 for leaves, -1 for free nodes
+		Proto::SceneObject *    m_Object;
+		mat4                    m_WorldToModel;
+	};
+
+	s32 AllocateNode();
+	void FreeNode(s32 index);
+	void FitLeaf(s32 leaf);
+	void InsertLeaf(s32 leaf);
+	void RemoveLeaf(s32 leaf);
+	s32 Balance(s32 index);
+	void Refit(s32 index);
+
+	Proto::SceneObject* Query(const vec3& origin, const vec3& ray, f32 maxTime, bool anyHit, f32& timeOfIntersection) const;
+
+	std::vector<Node> m_Nodes;
+	s32 m_Root;
+	s32 m_FreeList;
+	std::unordered_map<Proto::SceneObject*, s32> m_Leaves;
+};
+
+#endif
@@ -22,6 +22,7 @@ Creation Date:  24/Sep/2016
 #define CONSTRAINT_ITERATIONS 15 // how many iterations of constraint satisfaction each frame (more is rigid, less is soft)
 #include "BS.h"
 #include "HierachicalAABB.h"
+#include "TangentSpace.h"
 
 #include "Collision.h"
 class Cloth : public Mesh
@@ -38,6 +39,7 @@ private:
 	std::vector<ClothParticleConstraint> constraints; // alle constraints between particles as part of this cloth
 	std::vector<u32> pivolts;
 	HierachicalAABB hAABB;
+	Proto::TangentSpace tangentSpace; // the grid never changes, so its vertex-to-triangle table is built once
 
 	FluidParticle* getParticle(u32 x, u32 y) {
 		u32 index = y*num_particles_width + x;
@@ -200,6 +202,7 @@ public:
 		numIndices = mesh.numIndices;
 		numVertices = mesh.numVertices;
 		numTris = mesh.numTris;
+		tangentSpace.SetTopology(vertexBuffer.size(), indexBuffer);
 		UpdateMesh();
 
 
@@ -317,7 +320,7 @@ public:
 
 	void RebuildBV()
 	{
-		hAABB.BuildFromModel(vertexBuffer, indexBuffer, 8);
+		hAABB.BuildFromModel(positionBuffer, indexBuffer, 8);
 	}
 	/* drawing the cloth as a smooth shaded (and colored according to column) OpenGL triangular mesh
 	Called from the display() method
@@ -328,62 +331,22 @@ public:
 	|/ |
 	(x,y+1) *--* (x+1,y+1)
 
+	The vertex buffer is laid out like the particles, so positions are copied over directly and
+	the smooth normals come from the shared tangent space kernel over the plane's index buffer.
 	*/
 	void UpdateMesh()
 	{
-		// reset normals (which where written to last frame)
-		std::vector<FluidParticle>::iterator particle;
-		u32 total = particles.size();
-		for (u32 i = 0; i < total; ++i)
+		//<! update the positions within the vertex buffer
+		s32 total = static_cast<s32>(particles.size());
+#pragma omp parallel for
+		for (s32 i = 0; i < total; ++i)
 		{
-			(particles[i]).resetNormal();
+			vertexBuffer[i].pos = particles[i].getPos();
 		}
 
-		//create smooth per particle normals by adding up all the (hard) triangle normals that each particle is part of
-		for (u32 y = 0; y<num_particles_height -1; y++)
-		{
-			for (u32 x = 0; x<num_particles_width -1; x++)
-			{
-
-				Vec3 normal = calcTriangleNormal(
-					getParticle(x + 1, y), 
-					getParticle(x, y), 
-					getParticle(x, y + 1));
-				if (normal.x != normal.x || normal.y != normal.y || normal.z != normal.z) ;
-				else{
-					getParticle(x + 1, y)->addToNormal(normal);
-					getParticle(x, y)->addToNormal(normal);
-					getParticle(x, y + 1)->addToNormal(normal);
-				}
-				normal = calcTriangleNormal(
-					getParticle(x + 1, y + 1), 
-					getParticle(x + 1, y), 
-					getParticle(x, y + 1));
-				if (normal.x != normal.x || normal.y != normal.y || normal.z != normal.z);
-				else
-				{
-					getParticle(x + 1, y + 1)->addToNormal(normal);
-					getParticle(x + 1, y)->addToNormal(normal);
-					getParticle(x, y + 1)->addToNormal(normal);
-				}
-			}
-		}
-		//<! update the positions and normals within the vertex buffer
-		
-		//mesh.vertexBuffer.resize(num_particles_width * num_particles_height);
-
-		for (u32 y = 0; y < num_particles_height; y++)
-		{
-			for (u32 x = 0; x < num_particles_width; x++)
-			{
-				Vertex& v = vertexBuffer[y * num_particles_width + x];
-				FluidParticle* p = getParticle(x, y);
-				p->getVertex(v);
-
-				vertexBuffer[y * num_particles_width + x] = v;
-
-			}
-		}
+		//create smooth per vertex normals by adding up all the (hard) triangle normals that each vertex is part of
+		tangentSpace.ComputeNormals(vertexBuffer, indexBuffer);
+		UpdateCPUStreams();
 
 		//mesh.UpdateGPUVertexBuffer();
 
@@ -18,9 +18,11 @@ Creation Date:  19/Oct/2016
 #include "BS.h"
 #include "AABB.h"
 #include "Collision.h"
+#include "Model.h"
 #include "math.hpp"
 #include <iostream>
 #include <stdio.h>
+#include <cassert>
 #include <sstream>
 
 namespace Proto
@@ -315,7 +317,7 @@ namespace Proto
 				if (t1 > t2) std::swap(t1, t2);
 				// Compute the intersection of slab intersection intervals
 				if (t1 > tMin) tMin = t1;
-				if (t2 > tMax) tMax = t2;
+				if (t2 < tMax) tMax = t2;
 				// Exit with no collision as soon as slab intersection becomes empty
 				if (tMin > tMax) return false;
 			}
@@ -325,6 +327,128 @@ namespace Proto
 		return true;
 	}
 
+	bool IntersectLineAABB(const vec3& origin, const vec3& ray, const AABB& aabb, f32 tLow, f32 tHigh)
+	{
+		// Same slab test as IntersectRayAABB, clipped to [tLow, tHigh]
+		for (int i = 0; i < 3; i++) {
+			f32 e = aabb.m_Radius[i];
+			f32 max = aabb.m_Center[i] + e;
+			f32 min = aabb.m_Center[i] - e;
+			if (fabs(ray[i]) < EPSILON) {
+				if (origin[i] < min || origin[i] > max) return false;
+			}
+			else {
+				f32 ood = 1.0f / ray[i];
+				f32 t1 = (min - origin[i]) * ood;
+				f32 t2 = (max - origin[i]) * ood;
+				if (t1 > t2) std::swap(t1, t2);
+				if (t1 > tLow) tLow = t1;
+				if (t2 < tHigh) tHigh = t2;
+				if (tLow > tHigh) return false;
+			}
+		}
+		return true;
+	}
+
+	/*************************************************************************/
+	/*!
+	\fn bool IntersectRayModel(Model& model, const mat4& worldToModel,
+	                           const vec3& origin, const vec3& ray,
+	                           f32 maxTime, bool anyHit, f32& t)
+
+	\brief
+		Intersects a world space ray with the triangles of a model. The ray
+		is brought into model space with its direction left unnormalised,
+		so t is the same parameter along the ray in both spaces. Only the
+		nodes of the model's AABB tree the ray enters before the best hit
+		so far are opened.
+
+	\param anyHit
+		Stops at the first triangle found instead of the closest one.
+
+	\param t
+		Receives the time of the hit.
+
+	\return
+		true if a triangle was hit at 0 <= t < maxTime.
+	*/
+	/*************************************************************************/
+	bool IntersectRayModel(Model& model, const mat4& worldToModel, const vec3& origin, const vec3& ray,
+		f32 maxTime, bool anyHit, f32& t)
+	{
+		const HierachicalAABB& tree = model.GetHierachicalAABB();
+		if (tree.nodes.empty())
+			return false;
+
+		vec3 modelOrigin = vec3(worldToModel * vec4(origin, 1.f));
+		vec3 modelRay = vec3(worldToModel * vec4(ray, 0.f));
+
+		MeshPageFile* pages = model.GetMeshPages();
+		MeshPageCache& pageCache = MeshPageCache::GetInstance();
+		const TriangleRecords& records = model.GetTriangleRecords();
+
+		bool hasCollision(false);
+		f32 bestTime(maxTime);
+
+		//the tree depth is bounded, each level leaves at most one node behind
+		s32 stack[64];
+		s32 top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			s32 nodeIndex = stack[--top];
+			const HierachicalAABBNode& node = tree.nodes[nodeIndex];
+			if (!IntersectLineAABB(modelOrigin, modelRay, node.m_AABB, 0.f, bestTime))
+				continue;
+
+			if (node.m_LeftChild != -1 && node.m_RightChild != -1)
+			{
+				stack[top++] = node.m_RightChild;
+				stack[top++] = node.m_LeftChild;
+				continue;
+			}
+
+			//records of paged models are numbered from the start of their page
+			const TriangleRecords* triangles = &records;
+			u32 start = node.triangleStart;
+			u32 end = node.triangleStart + node.triangleCount;
+			MeshPagePtr page;
+			if (pages)
+			{
+				s32 pageIndex = pages->GetLeafPage(nodeIndex);
+				if (pageIndex != -1)
+					page = pageCache.GetTrianglePage(*pages, pageIndex);
+				if (!page)
+					continue;
+				//Model only keeps page files whose pages hold whole leaves
+				assert(start >= page->m_First && end - page->m_First <= page->m_Triangles.Size());
+				triangles = &page->m_Triangles;
+				start -= page->m_First;
+				end -= page->m_First;
+			}
+
+			//the line test also reports hits behind the origin, t < 0
+			for (u32 i = start; i < end; ++i)
+			{
+				f32 distance;
+				if (triangles->IntersectLine(i, modelOrigin, modelRay, bestTime, distance) && distance >= 0.f)
+				{
+					bestTime = distance;
+					hasCollision = true;
+					if (anyHit)
+					{
+						t = bestTime;
+						return true;
+					}
+				}
+			}
+		}
+
+		if (hasCollision)
+			t = bestTime;
+		return hasCollision;
+	}
+
 
 
 
@@ -622,15 +746,21 @@ namespace Proto
 
 	void hAABBhAABBCollision(HierachicalAABB& t1, HierachicalAABB& t2)
 	{
-		std::for_each(t1.nodes.begin(), t1.nodes.end(), [](HierachicalAABBNode& n){n.collided = false; });
-		std::for_each(t2.nodes.begin(), t2.nodes.end(), [](HierachicalAABBNode& n){n.collided = false; });
-
-		u32 total1(t1.nodes.size()), total2(t2.nodes.size());
-		u32 startIndex1(0);
-		u32 startIndex2(0);
-		MarkAABBAsCollided(t1, t2, startIndex1, startIndex2);
+		ClearCollided(t1);
+		ClearCollided(t2);
+		MarkCollided(t1, t2);
+	}
 
+	void ClearCollided(HierachicalAABB& t)
+	{
+		std::for_each(t.nodes.begin(), t.nodes.end(), [](HierachicalAABBNode& n){n.collided = false; });
+	}
 
+	void MarkCollided(HierachicalAABB& t1, HierachicalAABB& t2)
+	{
+		if (t1.nodes.empty() || t2.nodes.empty())
+			return;
+		MarkAABBAsCollided(t1, t2, 0, 0);
 	}
 
 	void MarkBSAsCollided(HierachicalBS& t1, HierachicalBS& t2, u32 i1, u32 i2)
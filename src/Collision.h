@@ -44,6 +44,10 @@ namespace Proto
 
 
 	void hAABBhAABBCollision(HierachicalAABB& t1, HierachicalAABB& t2);
+	// the two halves of hAABBhAABBCollision, so that one tree can be marked
+	// against several others without losing the earlier marks
+	void ClearCollided(HierachicalAABB& t);
+	void MarkCollided(HierachicalAABB& t1, HierachicalAABB& t2);
 	void hBShBSCollision(HierachicalBS& t1, HierachicalBS& t2);
 
 
@@ -52,6 +56,12 @@ namespace Proto
 
 
 	bool IntersectRayAABB(const vec3& origin, const vec3& ray,const  AABB& aabb, f32& tMin, vec3&intersect);
+	// true if the points origin + t * ray, tLow <= t <= tHigh, touch the box
+	bool IntersectLineAABB(const vec3& origin, const vec3& ray, const AABB& aabb, f32 tLow, f32 tHigh);
+	// closest (or with anyHit, the first found) triangle of the model hit by
+	// the world space ray at 0 <= t < maxTime, searched through its AABB tree
+	bool IntersectRayModel(Model& model, const mat4& worldToModel, const vec3& origin, const vec3& ray,
+		f32 maxTime, bool anyHit, f32& t);
 
 
 	bool IsCollided(BS& t_BS1, BS& t_BS2,
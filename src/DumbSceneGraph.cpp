@@ -7,6 +7,7 @@ Creation Date:  24/Sep/2016
 #include "DumbSceneGraph.h"
 #include "SceneObject.h"
 #include "Collision.h"
+#include <algorithm>
 DumbSceneGraph::DumbSceneGraph()
 {
 }
@@ -19,27 +20,34 @@ DumbSceneGraph::~DumbSceneGraph()
 
 
 
-SceneObject* DumbSceneGraph::GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection)
+namespace
+{
+	bool IntersectSurface(Proto::SceneObject* object, const vec3& origin, const vec3& ray, f32 maxTime, bool anyHit, f32& t)
+	{
+		Proto::Model* model = object->GetMeshRenderer()->GetModel();
+		if (!model)
+			return false;
+		return Proto::IntersectRayModel(*model, Inverse(object->GetMWMatrix()), origin, ray, maxTime, anyHit, t);
+	}
+}
+
+
+
+Proto::SceneObject* DumbSceneGraph::GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection)
 {
 	u32 total = surfaces.size();
-	SceneObject *o(nullptr);
+	Proto::SceneObject *o(nullptr);
 
 	f32 smallestT = FLT_MAX, ti = FLT_MAX;
 	for (u32 i = 0; i < total; ++i)
 	{
-		/*
-		bool collided = false;
-		SceneObject *to = surfaces[i];
-
-		collided = to->IntersectionTest(origin, ray, ti);
+		Proto::SceneObject *to = surfaces[i];
 
-		if (o == to) continue;
-		else if (collided && ti < smallestT)
+		if (IntersectSurface(to, origin, ray, smallestT, false, ti))
 		{
 			timeOfIntersection = smallestT = ti;
 			o = to;
 		}
-		*/
 	}
 	
 	return o;
@@ -48,35 +56,38 @@ SceneObject* DumbSceneGraph::GetClosestObject(const vec3& origin, const vec3& ra
 
 
 
-SceneObject* DumbSceneGraph::GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection)
+Proto::SceneObject* DumbSceneGraph::GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection)
 {
 	u32 total = surfaces.size();
-	SceneObject *o(nullptr);
 
-	f32 smallestT = FLT_MAX, ti = FLT_MAX;
+	f32 ti = FLT_MAX;
 	for (u32 i = 0; i < total; ++i)
 	{
-		/*
-		bool collided = false;
-		SceneObject *to = surfaces[i];
-
-		collided = to->IntersectionTest(origin, ray, ti);
+		Proto::SceneObject *to = surfaces[i];
 
-		if (o == to) continue;
-		else if (collided && ti < smallestT && ti < lightDistance)
+		if (IntersectSurface(to, origin, ray, lightDistance, true, ti))
 		{
-			timeOfIntersection = smallestT = ti;
-			o = to;
-			return o;
+			timeOfIntersection = ti;
+			return to;
 		}
-		*/
 	}
-	return o;
+	return nullptr;
 }
 
 
-void DumbSceneGraph::InsertObject(SceneObject* object)
+void DumbSceneGraph::InsertObject(Proto::SceneObject* object)
 {
 	surfaces.push_back(object);
 }
 
+
+void DumbSceneGraph::RemoveObject(Proto::SceneObject* object)
+{
+	surfaces.erase(std::remove(surfaces.begin(), surfaces.end(), object), surfaces.end());
+}
+
+
+void DumbSceneGraph::UpdateObject(Proto::SceneObject* /*object*/)
+{
+	//nothing is cached per object
+}
@@ -5,20 +5,23 @@ Creation Date:  24/Sep/2016
 - End Header -------------------------------------------------------*/
 #ifndef DUMB_SCENE_GRAPH_H
 #define DUMB_SCENE_GRAPH_H
+#include <vector>
 #include "ISceneGraph.h"
 
 
-
+// Tests every object in turn, the reference the other scene graphs are checked against.
 class DumbSceneGraph : public ISceneGraph
 {
 public:
 	DumbSceneGraph();
 	virtual ~DumbSceneGraph();
-	virtual SceneObject* GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection);
-	virtual SceneObject* GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection);
-	virtual void InsertObject(SceneObject* object);
+	virtual Proto::SceneObject* GetClosestObject(const vec3& origin, const vec3& ray, f32& timeOfIntersection);
+	virtual Proto::SceneObject* GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, f32& timeOfIntersection);
+	virtual void InsertObject(Proto::SceneObject* object);
+	virtual void RemoveObject(Proto::SceneObject* object);
+	virtual void UpdateObject(Proto::SceneObject* object);
 
 private:
-	std::vector<SceneObject*> surfaces;
+	std::vector<Proto::SceneObject*> surfaces;
 };
 #endif
\ No newline at end of file
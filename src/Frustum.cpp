@@ -0,0 +1,77 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      Frustum.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <cmath>
+#include "Frustum.h"
+
+namespace Proto
+{
+    /*************************************************************************/
+    /*!
+    \fn void Frustum::Extract(const mat4 & t_ProjView)
+
+    \brief
+        Reads the planes off the rows of the projection * view matrix: a
+        point is inside when -w <= x, y, z <= w in clip space, and each of
+        those inequalities is a plane in world space. The planes are
+        normalised so that Classify can compare distances with extents.
+    */
+    /*************************************************************************/
+    void Frustum::Extract(const mat4 & t_ProjView)
+    {
+        vec4 t_Rows[4];
+        for (u32 i = 0; i < 4; ++i)
+            t_Rows[i] = vec4(t_ProjView[0][i], t_ProjView[1][i], t_ProjView[2][i], t_ProjView[3][i]);
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            m_Planes[2 * i]     = t_Rows[3] + t_Rows[i];
+            m_Planes[2 * i + 1] = t_Rows[3] - t_Rows[i];
+        }
+
+        for (u32 i = 0; i < NO_OF_PLANES; ++i)
+        {
+            Plane & t_Plane = m_Planes[i];
+            f32 t_Length = sqrtf(t_Plane.a * t_Plane.a + t_Plane.b * t_Plane.b + t_Plane.c * t_Plane.c);
+            if (t_Length > 0.f)
+                t_Plane = vec4(t_Plane.a, t_Plane.b, t_Plane.c, t_Plane.d) / t_Length;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn u32 Frustum::Classify(const AABB & t_Box, u32 & t_PlaneMask) const
+
+    \brief
+        Tests a box against the planes set in t_PlaneMask. Planes the box
+        lies entirely inside of are cleared from the mask.
+
+    \return
+        FrustumTest::OUTSIDE as soon as the box is behind one plane,
+        FrustumTest::INSIDE once no plane is left in the mask.
+    */
+    /*************************************************************************/
+    u32 Frustum::Classify(const AABB & t_Box, u32 & t_PlaneMask) const
+    {
+        for (u32 i = 0; i < NO_OF_PLANES; ++i)
+        {
+            if (!(t_PlaneMask & (1u << i)))
+                continue;
+
+            const Plane & t_Plane = m_Planes[i];
+            f32 t_Distance = t_Plane.a * t_Box.m_Center.x + t_Plane.b * t_Box.m_Center.y +
+                             t_Plane.c * t_Box.m_Center.z + t_Plane.d;
+            f32 t_Extent = fabs(t_Plane.a) * t_Box.m_Radius.x + fabs(t_Plane.b) * t_Box.m_Radius.y +
+                           fabs(t_Plane.c) * t_Box.m_Radius.z;
+
+            if (t_Distance < -t_Extent)
+                return FrustumTest::OUTSIDE;
+            if (t_Distance >= t_Extent)
+                t_PlaneMask &= ~(1u << i);
+        }
+        return t_PlaneMask ? FrustumTest::INTERSECT : FrustumTest::INSIDE;
+    }
+}
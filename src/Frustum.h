@@ -0,0 +1,50 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      Frustum.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _FRUSTUM_H_
+#define _FRUSTUM_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Plane.h"
+#include "AABB.h"
+
+#define FRUSTUM_ALL_PLANES ((1u << NO_OF_PLANES) - 1)
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    struct FrustumTest
+    {
+        enum
+        {
+            OUTSIDE = 0,
+            INTERSECT,
+            INSIDE
+        };
+    };
+
+    // The six clip planes of a camera in world space, normals pointing in.
+    // Box tests take a mask of the planes still to be checked and clear the
+    // planes the box is entirely inside of, so that the children of a box
+    // in a hierarchy only test the planes their parent straddles.
+    class Frustum
+    {
+        public:
+
+            void            Extract(const mat4 & t_ProjView);
+            u32             Classify(const AABB & t_Box, u32 & t_PlaneMask) const;
+
+            Plane           m_Planes[NO_OF_PLANES];     // left, right, bottom, top, near, far
+    };
+}
+
+#endif
@@ -24,6 +24,7 @@ namespace Proto
 		, normalTexID(-1)
 		, normalTexID2(-1)
 		, m_RenderedTreeDepth(0)
+		, color(1.f, 1.f, 1.f)
     {}
 
     /*************************************************************************/
@@ -63,7 +64,7 @@ namespace Proto
         m_ModelID = t_ModelID;
         m_Model = ModelManager::GetInstance().GetModel(t_ModelID);
 
-		this->m_WorldSpaceHierachicalAABB = m_Model->GetHierachicalAABB();
+		this->m_WorldSpaceHierachicalAABB.CopyTopology(m_Model->GetHierachicalAABB());
 
 
 
@@ -109,11 +110,8 @@ namespace Proto
 		t_hAABB = hAABB;
 		t_hAABB.BuildFromModel(vertices, src.indexBuffer, t_hAABB.getMaxDepth());
 		*/
-        auto& src(m_Model->GetHierachicalAABB().nodes);
-        std::copy(src.begin(), src.end(), m_WorldSpaceHierachicalAABB.nodes.begin());
-        //t_hOBB = m_Model->GetHierachicalOBB();
-
-        m_WorldSpaceHierachicalAABB.ApplyTransform(t_MWMatrix, m_Model->GetHierachicalAABB());
+        //the topology was copied once in Init/SetModel, only the boxes move
+        t_hAABB.ApplyTransform(t_MWMatrix, m_Model->GetHierachicalAABB());
 	}
 
     /*************************************************************************/
@@ -166,39 +164,6 @@ namespace Proto
 		return m_WorldSpaceAABB;
 	}
 
-    /*************************************************************************/
-    /*!
-    \fn void GFXComponent::Draw(const mat4 & t_MWMatrix)
-
-    \brief
-    This function performs the drawing of the object.
-
-    \param t_MWMatrix
-    This is the model-world matrix.
-    */
-    /*************************************************************************/
-    void GFXComponent::Draw(const mat4& t_VMatrix, const mat4 &  t_MWMatrix, bool wireframe)
-    {
-
-        mat4 MVMat, normalMVMat;
-        ComputeObjMVMat(MVMat, normalMVMat, t_VMatrix, t_MWMatrix);
-
-        SendMVMat(MVMat, normalMVMat, mainMVMatLoc, mainNMVMatLoc);
-
-		if (wireframe || colorTexID == -1)
-		{
-			glUniform1i(textureOnLoc, false);
-		}
-		else
-		{
-			glUniform1i(textureOnLoc, true);
-			SendObjTexID(colorTexID, ActiveTexID::COLOR, textureLoc);
-		}
-
-        RenderMeshObj(this->m_Model->GetModelMesh(), wireframe);
-    }
-
-
 	void GFXComponent::DrawDebugSphere(const mat4 &  t_VMatrix)
 	{
 
@@ -275,7 +240,7 @@ namespace Proto
     {
         this->m_ModelID = t_ModelID;
         this->m_Model = ModelManager::GetInstance().GetModel(t_ModelID);
-		this->m_WorldSpaceHierachicalAABB = m_Model->GetHierachicalAABB();
+		this->m_WorldSpaceHierachicalAABB.CopyTopology(m_Model->GetHierachicalAABB());
 
     }
 
@@ -366,40 +331,73 @@ namespace Proto
 		color = c;
 	}
 
-    void GFXComponent::DrawDebugHierachicalAABB(const mat4 &  t_VMatrix)
+	s32 GFXComponent::GetColorTexture() const
+	{
+		return colorTexID;
+	}
+
+	const vec3& GFXComponent::GetDefaultColor() const
+	{
+		return color;
+	}
+
+    /*************************************************************************/
+    /*!
+    \fn void GFXComponent::CollectDebugHierachicalAABB(const Frustum & t_Frustum,
+                                                        std::vector<InstanceData> & t_Boxes)
+
+    \brief
+    Appends the world boxes at the selected depth that touch the frustum,
+    with the unit cube to box transform and the collided colour of each.
+    */
+    /*************************************************************************/
+    void GFXComponent::CollectDebugHierachicalAABB(const Frustum & t_Frustum, std::vector<InstanceData> & t_Boxes)
     {
-        u32 i = 0;
-        u32 e = this->m_WorldSpaceHierachicalAABB.nodes.size();
+        const std::vector<HierachicalAABBNode>& nodes = this->m_WorldSpaceHierachicalAABB.nodes;
+        if (nodes.empty())
+            return;
 
-        Model* t_BoxModel = ModelManager::GetInstance().GetModel("MODEL_DCUBE");
         u32 depth = u8CurrentBSPDepth - 1;
 
-        for (; i < e; ++i)
+        //subtrees outside the frustum are skipped whole, planes a box is
+        //inside of are not tested again below it
+        s32 stack[64];
+        u32 masks[64];
+        s32 top = 0;
+        stack[top] = 0;
+        masks[top++] = FRUSTUM_ALL_PLANES;
+        while (top > 0)
         {
-            HierachicalAABBNode& node(this->m_WorldSpaceHierachicalAABB.nodes[i]);
-            if (node.index != std::numeric_limits<u32>::max() &&
+            --top;
+            const HierachicalAABBNode& node(nodes[stack[top]]);
+            u32 mask = masks[top];
+            if (mask && t_Frustum.Classify(node.m_AABB, mask) == FrustumTest::OUTSIDE)
+                continue;
 
-                node.depth == depth
-                )
+            if (node.depth < depth)
             {
-
-                Proto::AABB& aabb(node.m_AABB);
-                mat4 mvMat, normalMVMat, mtwMat;
-                mtwMat = ScaleMatrix(vec3(aabb.m_Radius[0] * 2, aabb.m_Radius[1] * 2, aabb.m_Radius[2] * 2));
-                mtwMat[3][0] = aabb.m_Center.x;
-                mtwMat[3][1] = aabb.m_Center.y;
-                mtwMat[3][2] = aabb.m_Center.z;
-
-                vec3 c;
-                c.r = (node.collided) ? 255.f : 0.f;
-                c.g = (node.collided) ? 0.f : 255.f;
-                SendObjectColor(c, objectColorLoc);
-
-                ComputeObjMVMat(mvMat, normalMVMat, t_VMatrix, mtwMat);
-                SendMVMat(mvMat, normalMVMat, mainMVMatLoc, mainNMVMatLoc);
-                RenderMeshObj(t_BoxModel->GetModelMesh(), true);
-
+                if (node.m_LeftChild != -1 && node.m_RightChild != -1)
+                {
+                    stack[top] = node.m_LeftChild;
+                    masks[top++] = mask;
+                    stack[top] = node.m_RightChild;
+                    masks[top++] = mask;
+                }
+                continue;
             }
+
+            //the boxes are drawn as unlit lines, the normal matrix is unused
+            const Proto::AABB& aabb(node.m_AABB);
+            InstanceData box;
+            box.modelMat = ScaleMatrix(vec3(aabb.m_Radius[0] * 2, aabb.m_Radius[1] * 2, aabb.m_Radius[2] * 2));
+            box.modelMat[3][0] = aabb.m_Center.x;
+            box.modelMat[3][1] = aabb.m_Center.y;
+            box.modelMat[3][2] = aabb.m_Center.z;
+            box.normalMat[0] = vec3(1.f, 0.f, 0.f);
+            box.normalMat[1] = vec3(0.f, 1.f, 0.f);
+            box.normalMat[2] = vec3(0.f, 0.f, 1.f);
+            box.color = (node.collided) ? vec3(1.f, 0.f, 0.f) : vec3(0.f, 1.f, 0.f);
+            t_Boxes.push_back(box);
         }
     }
 
@@ -17,6 +17,7 @@ Creation Date:  24/Sep/2016
 #include "HierachicalAABB.h"
 #include "BS.h"
 #include "HierachicalBS.h"
+#include "Frustum.h"
 
 // ==========================
 // class/ function prototypes
@@ -41,13 +42,12 @@ namespace Proto
 									const vec3   & t_RotVec,
 									const vec3   & t_ScaleVec);
 
-        void				Draw(	const mat4 &  t_VMatrix, 
-									const mat4 &  t_MWMatrix ,
-									bool wireframe = false);
 		void				DrawDebugSphere(const mat4 &  t_VMatrix);
 		void				DrawDebugAABB(const mat4 &  t_VMatrix);
 
-		void				DrawDebugHierachicalAABB(const mat4 &  t_VMatrix);
+		// appends the boxes at the selected depth inside the frustum, drawn
+		// later for all objects together
+		void				CollectDebugHierachicalAABB(const Frustum & t_Frustum, std::vector<InstanceData> & t_Boxes);
 
 		void				UpdateWorldSpaceBoundingSphere(const vec3 &  t_translationVec, const vec3& t_ScaleVec, const vec3& t_RotVec, BS& t_worldSpaceBS);
 		void				UpdateWorldSpaceAABB(const mat4 &  t_MWMatrix, AABB& t_worldSpaceAABB);
@@ -57,6 +57,8 @@ namespace Proto
 		void				SetNormalMapTexture(s32 colorTexID);
 		void				SetNormalMapTexture2(s32 colorTexID);
 		void				SetDefaultColor(const vec3& c);
+		s32					GetColorTexture() const;
+		const vec3&			GetDefaultColor() const;
 
         HierachicalAABB&	GetHAABB();
 
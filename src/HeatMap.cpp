@@ -0,0 +1,655 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMap.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <cassert>
+#include <chrono>
+#include "HeatMap.h"
+#include "Model.h"
+#include "SceneObject.h"
+#include "GFXComponent.h"
+#include "Collision.h"
+
+namespace Proto
+{
+    /*************************************************************************/
+    /*!
+    \fn HeatMapJob::HeatMapJob()
+
+    \brief
+        This is the default constructor of an empty (invalid) heatmap job.
+    */
+    /*************************************************************************/
+    HeatMapJob::HeatMapJob()
+        : m_ShadedModel(nullptr)
+        , m_OpposingModel(nullptr)
+        , m_MaxDistance(0.f)
+    {
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn HeatMapJob::HeatMapJob(SceneObject * t_ShadedObject, 
+                               SceneObject * t_OpposingObject,
+                               f32 t_MaxDistance)
+
+    \brief
+        Snapshots the models and current model-world matrices of the two
+        objects.
+
+    \param t_ShadedObject
+        The object whose vertices receive the heatmap values.
+
+    \param t_OpposingObject
+        The object whose surface is measured against.
+
+    \param t_MaxDistance
+        The tolerance band. Only surfaces within this distance are searched
+        and the heatmap colours are scaled to it.
+    */
+    /*************************************************************************/
+    HeatMapJob::HeatMapJob(SceneObject * t_ShadedObject, SceneObject * t_OpposingObject, f32 t_MaxDistance)
+        : m_ShadedModel(nullptr)
+        , m_OpposingModel(nullptr)
+        , m_MaxDistance(t_MaxDistance)
+    {
+        if (t_ShadedObject == nullptr || t_OpposingObject == nullptr) return;
+
+        if (!t_ShadedObject->GetMeshRenderer() || !t_OpposingObject->GetMeshRenderer()) return;
+
+        m_ShadedModel   = t_ShadedObject->GetMeshRenderer()->GetModel();
+        m_OpposingModel = t_OpposingObject->GetMeshRenderer()->GetModel();
+        m_ShadedMTW     = t_ShadedObject->GetMWMatrix();
+        m_OpposingMTW   = t_OpposingObject->GetMWMatrix();
+    }
+
+    bool HeatMapJob::IsValid() const
+    {
+        return m_ShadedModel != nullptr && m_OpposingModel != nullptr && m_MaxDistance > 0.f;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn HeatMapContext::HeatMapContext(const HeatMapJob & t_Job)
+
+    \brief
+        Precomputes the matrices used by every vertex query.
+        Rays are cast in the model space of the opposing object, so its
+        model-space tree and vertices are used as-is and never copied or
+        transformed.
+    */
+    /*************************************************************************/
+    HeatMapContext::HeatMapContext(const HeatMapJob & t_Job)
+        : m_ShadedPositions(t_Job.m_ShadedModel->GetModelMesh().positionBuffer)
+        , m_ShadedNormals(t_Job.m_ShadedModel->GetModelMesh().normalBuffer)
+        , m_OpposingTree(t_Job.m_OpposingModel->GetHierachicalAABB())
+        , m_OpposingTriangles(t_Job.m_OpposingModel->GetTriangleRecords())
+        , m_ShadedPages(t_Job.m_ShadedModel->GetMeshPages())
+        , m_OpposingPages(t_Job.m_OpposingModel->GetMeshPages())
+        , m_ShadedVertexCount(t_Job.m_ShadedModel->GetVertexCount())
+        , m_ShadedMTW(t_Job.m_ShadedMTW)
+        , m_ShadedNormalMTW(Mat3(Transpose(Inverse(t_Job.m_ShadedMTW))))
+        , m_WorldToOpposing(Inverse(t_Job.m_OpposingMTW))
+        , m_MaxDistance(t_Job.m_MaxDistance)
+    {
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn HeatMapValue ComputeVertexHeatMap(const HeatMapContext &  t_Context, 
+                                          const std::vector<s32> & t_OpposingLeaves,
+                                          u32 t_VertexIndex)
+
+    \brief
+        Casts a ray along the world space normal of a shaded vertex (both 
+        directions) against the triangle records of the given opposing 
+        leaves and encodes the closest hit within the job's maximum distance.
+
+    \param t_OpposingLeaves
+        The candidate leaves of the shaded leaf the vertex belongs to.
+
+    \return
+        With s = 0.5 * t / maxDistance, x is 0.5 - s for hits in front of the
+        vertex and 0.5 + s for hits behind it. y is 1 when no surface was 
+        found within the band.
+    */
+    /*************************************************************************/
+    HeatMapValue ComputeVertexHeatMap(const HeatMapContext & t_Context, const std::vector<s32> & t_OpposingLeaves, u32 t_VertexIndex)
+    {
+        MeshPageCache& pageCache = MeshPageCache::GetInstance();
+        Vec3 position, normal;
+        if (t_Context.m_ShadedPages)
+        {
+            MeshPagePtr page = pageCache.GetVertexPage(*t_Context.m_ShadedPages, t_Context.m_ShadedPages->GetVertexPage(t_VertexIndex));
+            if (!page)
+                return HeatMapValue(0.5f, 1.f);
+            position = page->m_Positions[t_VertexIndex - page->m_First];
+            normal = page->m_Normals[t_VertexIndex - page->m_First];
+        }
+        else
+        {
+            position = t_Context.m_ShadedPositions[t_VertexIndex];
+            normal = t_Context.m_ShadedNormals[t_VertexIndex];
+        }
+
+        //get world space position of vertex and normal direction of shaded vertex
+        Vec3 worldSpacePosition = Vec3(t_Context.m_ShadedMTW * Vec4(position, 1.f));
+        Vec3 worldSpaceNormal = Normalise(t_Context.m_ShadedNormalMTW * normal);
+
+        //bring the ray into the opposing model space, the direction is left
+        //unnormalised so that t is still measured in world units
+        Vec3 origin = Vec3(t_Context.m_WorldToOpposing * Vec4(worldSpacePosition, 1.f));
+        Vec3 direction = Vec3(t_Context.m_WorldToOpposing * Vec4(worldSpaceNormal, 0.f));
+
+        bool hasCollision(false);
+        f32 bestTime(t_Context.m_MaxDistance);
+        bool isTriangleBehindVertex(false);
+
+        u32 totalLeaves = t_OpposingLeaves.size();
+        for (u32 i = 0; i < totalLeaves; ++i)
+        {
+            const HierachicalAABBNode& leaf = t_Context.m_OpposingTree.nodes[t_OpposingLeaves[i]];
+
+            //only the part of the normal line closer than the best hit so far is of interest
+            if (!IntersectLineAABB(origin, direction, leaf.m_AABB, -bestTime, bestTime))
+                continue;
+
+            //records of paged models are numbered from the start of their page
+            const TriangleRecords* triangles = &t_Context.m_OpposingTriangles;
+            u32 start = leaf.triangleStart;
+            u32 end = leaf.triangleStart + leaf.triangleCount;
+            MeshPagePtr page;
+            if (t_Context.m_OpposingPages)
+            {
+                s32 pageIndex = t_Context.m_OpposingPages->GetLeafPage(t_OpposingLeaves[i]);
+                if (pageIndex != -1)
+                    page = pageCache.GetTrianglePage(*t_Context.m_OpposingPages, pageIndex);
+                if (!page)
+                    continue;
+                //Model only keeps page files whose pages hold whole leaves
+                assert(start >= page->m_First && end - page->m_First <= page->m_Triangles.Size());
+                triangles = &page->m_Triangles;
+                start -= page->m_First;
+                end -= page->m_First;
+            }
+
+            //one test covers both directions, t < 0 is behind the vertex
+            for (u32 j = start; j < end; ++j)
+            {
+                f32 distance;
+                if (triangles->IntersectLine(j, origin, direction, bestTime, distance))
+                {
+                    isTriangleBehindVertex = distance < 0.f;
+                    bestTime = fabs(distance);
+                    hasCollision = true;
+                }
+            }
+        }
+
+        if (!hasCollision)
+            return HeatMapValue(0.5f, 1.f);
+
+        //rescale the band to [0, 0.5] and invert value if behind the vertex
+        bestTime = 0.5f * bestTime / t_Context.m_MaxDistance;
+        bestTime = (isTriangleBehindVertex) ? bestTime + 0.5f : 0.5f - bestTime;
+        return HeatMapValue(bestTime, 0.f);
+    }
+
+    // Walks the shaded and the opposing tree together in world space. 
+    // A pair of nodes is only split further while the distance between 
+    // their boxes is within the band, which is tested by growing the 
+    // shaded box by the band.
+    struct HeatMapDualTree
+    {
+        HeatMapDualTree(const HeatMapJob & t_Job, HeatMapCandidates & t_Result);
+
+        void    CollectLeafPairs(s32 t_Shaded, s32 t_Opposing);
+
+        const HierachicalAABB &     m_ShadedTree;
+        const HierachicalAABB &     m_OpposingTree;
+        std::vector<AABB> &         m_ShadedBoxes;
+        std::vector<AABB> &         m_OpposingBoxes;
+        HeatMapCandidates &         m_Result;
+
+    private:
+        HeatMapDualTree & operator = (const HeatMapDualTree &);
+    };
+
+    HeatMapDualTree::HeatMapDualTree(const HeatMapJob & t_Job, HeatMapCandidates & t_Result)
+        : m_ShadedTree(t_Job.m_ShadedModel->GetHierachicalAABB())
+        , m_OpposingTree(t_Job.m_OpposingModel->GetHierachicalAABB())
+        , m_ShadedBoxes(t_Result.m_ShadedBoxes)
+        , m_OpposingBoxes(t_Result.m_OpposingBoxes)
+        , m_Result(t_Result)
+    {
+        u32 total = m_ShadedTree.nodes.size();
+        m_ShadedBoxes.resize(total);
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (m_ShadedTree.nodes[i].index == -1)
+                continue;
+            m_ShadedBoxes[i].UpdateAABB(t_Job.m_ShadedMTW, m_ShadedTree.nodes[i].m_AABB);
+            m_ShadedBoxes[i].m_Radius += vec3(t_Job.m_MaxDistance);
+        }
+
+        total = m_OpposingTree.nodes.size();
+        m_OpposingBoxes.resize(total);
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (m_OpposingTree.nodes[i].index != -1)
+                m_OpposingBoxes[i].UpdateAABB(t_Job.m_OpposingMTW, m_OpposingTree.nodes[i].m_AABB);
+        }
+    }
+
+    void HeatMapDualTree::CollectLeafPairs(s32 t_Shaded, s32 t_Opposing)
+    {
+        if (!AABBAABBCollision(m_ShadedBoxes[t_Shaded], m_OpposingBoxes[t_Opposing]))
+            return;
+
+        const HierachicalAABBNode& shaded = m_ShadedTree.nodes[t_Shaded];
+        const HierachicalAABBNode& opposing = m_OpposingTree.nodes[t_Opposing];
+        bool shadedIsLeaf = shaded.m_LeftChild == -1 || shaded.m_RightChild == -1;
+        bool opposingIsLeaf = opposing.m_LeftChild == -1 || opposing.m_RightChild == -1;
+
+        if (shadedIsLeaf && opposingIsLeaf)
+        {
+            m_Result.m_OpposingLeaves[t_Shaded].push_back(t_Opposing);
+        }
+        else if (opposingIsLeaf || (!shadedIsLeaf && shaded.depth <= opposing.depth))
+        {
+            CollectLeafPairs(shaded.m_LeftChild, t_Opposing);
+            CollectLeafPairs(shaded.m_RightChild, t_Opposing);
+        }
+        else
+        {
+            CollectLeafPairs(t_Shaded, opposing.m_LeftChild);
+            CollectLeafPairs(t_Shaded, opposing.m_RightChild);
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void FindCandidateLeaves(const HeatMapJob & t_Job, 
+                                 HeatMapCandidates & t_Result)
+
+    \brief
+        Finds, for every shaded leaf, the opposing leaves within the job's 
+        band, and the leaf each shaded vertex is evaluated in.
+        A vertex lies inside the box of every leaf it belongs to, so any 
+        of them holds the complete candidate list; the first one is used 
+        so that each vertex is evaluated once. Vertices whose leaf has no
+        candidates are a certain "no hit" and get -1.
+    */
+    /*************************************************************************/
+    void FindCandidateLeaves(const HeatMapJob & t_Job, HeatMapCandidates & t_Result)
+    {
+        //the leaf lists are emptied rather than destroyed, so that the next
+        //job reuses their memory
+        for (u32 i = 0; i < t_Result.m_OpposingLeaves.size(); ++i)
+            t_Result.m_OpposingLeaves[i].clear();
+        t_Result.m_VertexLeaf.clear();
+        if (!t_Job.IsValid())
+            return;
+
+        const HierachicalAABB& shadedTree = t_Job.m_ShadedModel->GetHierachicalAABB();
+        u32 total = shadedTree.nodes.size();
+        t_Result.m_OpposingLeaves.resize(total);
+        t_Result.m_VertexLeaf.assign(t_Job.m_ShadedModel->GetVertexCount(), -1);
+
+        HeatMapDualTree t_DualTree(t_Job, t_Result);
+        if (shadedTree.nodes.empty() || t_DualTree.m_OpposingTree.nodes.empty())
+            return;
+
+        t_DualTree.CollectLeafPairs(0, 0);
+
+        //paged models have dropped their leaf index lists and keep the first leaf of each vertex instead
+        MeshPageFile* pages = t_Job.m_ShadedModel->GetMeshPages();
+        if (pages)
+        {
+            for (u32 i = 0; i < t_Result.m_VertexLeaf.size(); ++i)
+            {
+                s32 leaf = pages->GetVertexLeaf(i);
+                if (leaf != -1 && !t_Result.m_OpposingLeaves[leaf].empty())
+                    t_Result.m_VertexLeaf[i] = leaf;
+            }
+            return;
+        }
+
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (t_Result.m_OpposingLeaves[i].empty())
+                continue;
+
+            const std::vector<int>& indices = shadedTree.nodes[i].indices;
+            for (u32 j = 0; j < indices.size(); ++j)
+            {
+                if (t_Result.m_VertexLeaf[indices[j]] == -1)
+                    t_Result.m_VertexLeaf[indices[j]] = i;
+            }
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn HeatMapProgress::HeatMapProgress()
+
+    \brief
+        This is the default constructor of an idle progressive evaluation.
+    */
+    /*************************************************************************/
+    HeatMapProgress::HeatMapProgress()
+        : m_AdjacencyModel(nullptr)
+        , m_Next(0)
+    {
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapProgress::Begin(const HeatMapJob & t_Job)
+
+    \brief
+        Starts evaluating t_Job from scratch. Vertices that cannot reach the
+        opposing model are marked as no hit right away. The evaluation order 
+        and the vertex adjacency are only rebuilt when the shaded model 
+        changes.
+    */
+    /*************************************************************************/
+    void HeatMapProgress::Begin(const HeatMapJob & t_Job)
+    {
+        m_Job = t_Job;
+        m_Next = 0;
+
+        if (!m_Job.IsValid())
+        {
+            m_Order.clear();
+            m_Values.clear();
+            return;
+        }
+
+        const Mesh& t_Mesh = m_Job.m_ShadedModel->GetModelMesh();
+        u32 total = m_Job.m_ShadedModel->GetVertexCount();
+
+        if (m_AdjacencyModel != m_Job.m_ShadedModel || m_Order.size() != total)
+        {
+            BuildOrder(t_Mesh, total);
+            BuildAdjacency(t_Mesh, total);
+            m_AdjacencyModel = m_Job.m_ShadedModel;
+        }
+
+        m_Values.resize(total);
+
+        //vertices out of reach of the opposing model are settled up front
+        FindCandidateLeaves(m_Job, m_Candidates);
+        m_Computed.assign(total, 0);
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (m_Candidates.m_VertexLeaf[i] == -1)
+            {
+                m_Values[i] = HeatMapValue(0.5f, 1.f);
+                m_Computed[i] = 1;
+            }
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool HeatMapProgress::Step(f32 t_BudgetMs, 
+                                   const std::atomic<bool> * t_Cancelled)
+
+    \brief
+        Evaluates vertices in order until t_BudgetMs milliseconds have 
+        passed. A budget of 0 or less evaluates everything that is left.
+
+    \return
+        true once every vertex has been evaluated.
+    */
+    /*************************************************************************/
+    bool HeatMapProgress::Step(f32 t_BudgetMs, const std::atomic<bool> * t_Cancelled)
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        if (IsDone())
+            return true;
+
+        HeatMapContext t_Context(m_Job);
+        Clock::time_point t_Start = Clock::now();
+        u32 total = m_Order.size();
+
+        while (m_Next < total)
+        {
+            //poll the clock and the cancel flag in small batches
+            u32 batchEnd = (std::min)(m_Next + 64, total);
+            for (; m_Next < batchEnd; ++m_Next)
+            {
+                u32 vertex = m_Order[m_Next];
+                if (m_Computed[vertex])
+                    continue;
+                s32 leaf = m_Candidates.m_VertexLeaf[vertex];
+                m_Values[vertex] = ComputeVertexHeatMap(t_Context, m_Candidates.m_OpposingLeaves[leaf], vertex);
+                m_Computed[vertex] = 1;
+            }
+
+            if (t_Cancelled && t_Cancelled->load())
+                return false;
+
+            if (t_BudgetMs > 0.f)
+            {
+                std::chrono::duration<f32, std::milli> elapsed = Clock::now() - t_Start;
+                if (elapsed.count() >= t_BudgetMs)
+                    break;
+            }
+        }
+        return IsDone();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapProgress::Resolve(HeatMapBufferType & t_Result) const
+
+    \brief
+        Writes the current estimate of every vertex. Evaluated vertices
+        keep their value. The others take the value of the vertex they
+        collapse onto in the finest LOD where that one is evaluated, and
+        the rest are filled ring by ring with the average of their 
+        already filled neighbours. Vertices that cannot
+        be reached from an evaluated vertex are marked as having no hit.
+    */
+    /*************************************************************************/
+    void HeatMapProgress::Resolve(HeatMapBufferType & t_Result) const
+    {
+        if (IsDone())
+        {
+            t_Result = m_Values;
+            return;
+        }
+
+        u32 total = m_Values.size();
+        t_Result.resize(total);
+
+        // 1 = filled, 2 = filled in the ring being built
+        std::vector<u8>& filled = m_Filled;
+        std::vector<u32>& frontier = m_Frontier;
+        std::vector<u32>& nextFrontier = m_NextFrontier;
+        filled = m_Computed;
+        frontier.clear();
+
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (filled[i])
+            {
+                t_Result[i] = m_Values[i];
+                frontier.push_back(i);
+            }
+        }
+
+        //borrow from the LOD representatives, finest level first
+        const MeshLODBufferType& lods = m_Job.m_ShadedModel->GetModelMesh().lods;
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (filled[i])
+                continue;
+            for (u32 k = 0; k < lods.size(); ++k)
+            {
+                if (lods[k].vertexRemap.size() != total)
+                    break;
+                u32 r = lods[k].vertexRemap[i];
+                if (m_Computed[r])
+                {
+                    t_Result[i] = m_Values[r];
+                    filled[i] = 1;
+                    frontier.push_back(i);
+                    break;
+                }
+            }
+        }
+
+        while (!frontier.empty())
+        {
+            nextFrontier.clear();
+
+            //collect the unfilled one-ring of the current frontier
+            for (u32 i = 0; i < frontier.size(); ++i)
+            {
+                u32 v = frontier[i];
+                for (u32 j = m_AdjStart[v]; j < m_AdjStart[v + 1]; ++j)
+                {
+                    u32 n = m_Adj[j];
+                    if (filled[n] == 0)
+                    {
+                        filled[n] = 2;
+                        nextFrontier.push_back(n);
+                    }
+                }
+            }
+
+            //average only the neighbours filled in earlier rings
+            for (u32 i = 0; i < nextFrontier.size(); ++i)
+            {
+                u32 v = nextFrontier[i];
+                HeatMapValue sum(0.f, 0.f);
+                f32 count = 0.f;
+                for (u32 j = m_AdjStart[v]; j < m_AdjStart[v + 1]; ++j)
+                {
+                    u32 n = m_Adj[j];
+                    if (filled[n] == 1)
+                    {
+                        sum += t_Result[n];
+                        count += 1.f;
+                    }
+                }
+                t_Result[v] = sum / count;
+            }
+
+            for (u32 i = 0; i < nextFrontier.size(); ++i)
+                filled[nextFrontier[i]] = 1;
+
+            std::swap(frontier, nextFrontier);
+        }
+
+        for (u32 i = 0; i < total; ++i)
+        {
+            if (!filled[i])
+                t_Result[i] = HeatMapValue(0.5f, 1.f);
+        }
+    }
+
+    bool HeatMapProgress::IsDone() const
+    {
+        return m_Next >= m_Order.size();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapProgress::BuildOrder(const Mesh & t_Mesh, u32 t_Count)
+
+    \brief
+        Orders the vertices coarse to fine. Vertices are grouped by the 
+        coarsest LOD that keeps them, coarsest group first. Within a group,
+        every stride-th vertex comes first, then the midpoints of those 
+        strides, halving the stride each time until every vertex is listed
+        once.
+    */
+    /*************************************************************************/
+    void HeatMapProgress::BuildOrder(const Mesh & t_Mesh, u32 t_Count)
+    {
+        u32 total = t_Count;
+        m_Order.clear();
+        m_Order.reserve(total);
+        if (total == 0)
+            return;
+
+        //levels whose remap is usable, finest first
+        const MeshLODBufferType& lods = t_Mesh.lods;
+        u32 numLevels = 0;
+        while (numLevels < lods.size() && lods[numLevels].vertexRemap.size() == total)
+            ++numLevels;
+
+        //group g holds the vertices kept by lods[g - 1] but not lods[g]
+        std::vector< std::vector<u32> > groups(numLevels + 1);
+        for (u32 i = 0; i < total; ++i)
+        {
+            u32 g = 0;
+            while (g < numLevels && lods[g].vertexRemap[i] == i)
+                ++g;
+            groups[g].push_back(i);
+        }
+
+        for (u32 g = numLevels + 1; g-- > 0;)
+        {
+            const std::vector<u32>& group = groups[g];
+            u32 count = group.size();
+            if (count == 0)
+                continue;
+
+            u32 stride = 1;
+            while (stride < count / 2)
+                stride <<= 1;
+
+            for (u32 i = 0; i < count; i += stride)
+                m_Order.push_back(group[i]);
+
+            for (; stride > 1; stride >>= 1)
+            {
+                for (u32 i = stride >> 1; i < count; i += stride)
+                    m_Order.push_back(group[i]);
+            }
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapProgress::BuildAdjacency(const Mesh & t_Mesh, u32 t_Count)
+
+    \brief
+        Builds the one-ring of every vertex from the triangle list in 
+        compressed row form. Interior edges list a neighbour twice, which
+        weights every neighbour alike and is left as is.
+    */
+    /*************************************************************************/
+    void HeatMapProgress::BuildAdjacency(const Mesh & t_Mesh, u32 t_Count)
+    {
+        const IndexBufferType& indices = t_Mesh.indexBuffer;
+        u32 total = t_Count;
+        u32 numIndices = indices.size() - indices.size() % 3;
+
+        m_AdjStart.assign(total + 1, 0);
+        for (u32 i = 0; i < numIndices; ++i)
+            m_AdjStart[indices[i] + 1] += 2;
+
+        for (u32 i = 0; i < total; ++i)
+            m_AdjStart[i + 1] += m_AdjStart[i];
+
+        m_Adj.resize(m_AdjStart[total]);
+        std::vector<u32> cursor(m_AdjStart.begin(), m_AdjStart.end() - 1);
+
+        for (u32 i = 0; i < numIndices; i += 3)
+        {
+            u32 a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            m_Adj[cursor[a]++] = b; m_Adj[cursor[a]++] = c;
+            m_Adj[cursor[b]++] = c; m_Adj[cursor[b]++] = a;
+            m_Adj[cursor[c]++] = a; m_Adj[cursor[c]++] = b;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMap.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _HEATMAP_H_
+#define _HEATMAP_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <atomic>
+#include <vector>
+#include "Mesh.hpp"
+#include "HierachicalAABB.h"
+#include "TriangleRecords.h"
+#include "MeshPages.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    class Model;
+    class SceneObject;
+
+    // A heatmap request, captured by value so that it can be evaluated
+    // while the scene objects keep moving.
+    struct HeatMapJob
+    {
+        HeatMapJob();
+        HeatMapJob(SceneObject * t_ShadedObject, SceneObject * t_OpposingObject, f32 t_MaxDistance);
+
+        bool        IsValid() const;
+
+        Model *     m_ShadedModel;
+        Model *     m_OpposingModel;
+        mat4        m_ShadedMTW;
+        mat4        m_OpposingMTW;
+        f32         m_MaxDistance;  // surfaces further away than this count as no hit
+    };
+
+    // Per-job constants shared by every vertex query of the job.
+    // Paged models leave their buffers empty and are read through 
+    // MeshPageCache instead.
+    struct HeatMapContext
+    {
+        HeatMapContext(const HeatMapJob & t_Job);
+
+        const PositionBufferType &  m_ShadedPositions;
+        const PositionBufferType &  m_ShadedNormals;
+        const HierachicalAABB &     m_OpposingTree;
+        const TriangleRecords &     m_OpposingTriangles;
+        MeshPageFile *              m_ShadedPages;
+        MeshPageFile *              m_OpposingPages;
+        u32                         m_ShadedVertexCount;
+        mat4                        m_ShadedMTW;
+        mat3                        m_ShadedNormalMTW;
+        mat4                        m_WorldToOpposing;
+        f32                         m_MaxDistance;
+
+    private:
+        HeatMapContext & operator = (const HeatMapContext &);
+    };
+
+    // Opposing leaves that can hold a hit, per shaded leaf
+    struct HeatMapCandidates
+    {
+        std::vector<std::vector<s32> >  m_OpposingLeaves;   // indexed by shaded node
+        std::vector<s32>                m_VertexLeaf;       // shaded leaf each vertex is evaluated in, -1 for no hit
+
+        // world space node boxes of the dual tree walk, kept here so that
+        // the next job reuses their memory
+        std::vector<AABB>               m_ShadedBoxes;      // grown by the band
+        std::vector<AABB>               m_OpposingBoxes;
+    };
+
+    void            FindCandidateLeaves(const HeatMapJob & t_Job, HeatMapCandidates & t_Result);
+
+    HeatMapValue    ComputeVertexHeatMap(const HeatMapContext &     t_Context, 
+                                         const std::vector<s32> &   t_OpposingLeaves, 
+                                         u32                        t_VertexIndex);
+
+    // Evaluates a heatmap job a slice at a time, coarse to fine.
+    // Vertices are visited in a stratified order so that every slice 
+    // covers the whole mesh, vertices kept by the coarsest LOD first.
+    // Vertices that have not been evaluated yet are filled in from their
+    // LOD representative or their evaluated neighbours on Resolve.
+    class HeatMapProgress
+    {
+        public:
+
+            HeatMapProgress();
+
+            void        Begin(const HeatMapJob & t_Job);
+            bool        Step(f32 t_BudgetMs, const std::atomic<bool> * t_Cancelled = nullptr);
+            void        Resolve(HeatMapBufferType & t_Result) const;
+            bool        IsDone() const;
+
+        private:
+
+            void        BuildOrder(const Mesh & t_Mesh, u32 t_Count);
+            void        BuildAdjacency(const Mesh & t_Mesh, u32 t_Count);
+
+            HeatMapJob              m_Job;
+            const Model *           m_AdjacencyModel;   // model m_AdjStart/m_Adj were built for
+            std::vector<u32>        m_Order;            // stratified evaluation order
+            std::vector<u32>        m_AdjStart;         // one-ring of vertex i is m_Adj[m_AdjStart[i], m_AdjStart[i+1])
+            std::vector<u32>        m_Adj;
+            std::vector<u8>         m_Computed;
+            HeatMapBufferType       m_Values;
+            HeatMapCandidates       m_Candidates;
+            u32                     m_Next;
+
+            // Resolve scratch, kept so that previews do not allocate
+            mutable std::vector<u8>     m_Filled;
+            mutable std::vector<u32>    m_Frontier;
+            mutable std::vector<u32>    m_NextFrontier;
+    };
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMapTracker.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include "HeatMapTracker.h"
+#include "HeatMapWorker.h"
+
+namespace Proto
+{
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapTracker::Clear()
+
+    \brief
+        Stops tracking every result and frees their worker slots.
+    */
+    /*************************************************************************/
+    void HeatMapTracker::Clear()
+    {
+        HeatMapWorker & t_Worker = HeatMapWorker::GetInstance();
+        for (u32 i = 0; i < m_Dependencies.size(); ++i)
+            t_Worker.Release(m_Dependencies[i].m_Shaded, m_Dependencies[i].m_Opposing);
+        m_Dependencies.clear();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapTracker::Track(SceneObjectHandle t_Shaded,
+                                   SceneObjectHandle t_Opposing)
+
+    \brief
+        Starts tracking the heatmap of t_Shaded against t_Opposing. It is
+        submitted by the next SubmitInvalidated.
+    */
+    /*************************************************************************/
+    void HeatMapTracker::Track(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing)
+    {
+        for (u32 i = 0; i < m_Dependencies.size(); ++i)
+        {
+            if (m_Dependencies[i].m_Shaded == t_Shaded && m_Dependencies[i].m_Opposing == t_Opposing)
+                return;
+        }
+
+        Dependency t_Dependency;
+        t_Dependency.m_Shaded = t_Shaded;
+        t_Dependency.m_Opposing = t_Opposing;
+        t_Dependency.m_ShadedVersion = 0;
+        t_Dependency.m_OpposingVersion = 0;
+        t_Dependency.m_MaxDistance = 0.f;
+        t_Dependency.m_Submitted = false;
+        m_Dependencies.push_back(t_Dependency);
+    }
+
+    void HeatMapTracker::Invalidate()
+    {
+        for (u32 i = 0; i < m_Dependencies.size(); ++i)
+            m_Dependencies[i].m_Submitted = false;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn u32 HeatMapTracker::SubmitInvalidated(f32 t_MaxDistance)
+
+    \brief
+        Submits every tracked result whose objects moved, or that was
+        computed with another search distance, and records the versions it
+        now depends on. Call after SceneObjectManager::UpdateAll so the
+        versions match the transforms the jobs capture.
+    */
+    /*************************************************************************/
+    u32 HeatMapTracker::SubmitInvalidated(f32 t_MaxDistance)
+    {
+        SceneObjectManager & t_Manager = SceneObjectManager::GetInstance();
+        HeatMapWorker & t_Worker = HeatMapWorker::GetInstance();
+        u32 t_Submitted = 0;
+
+        for (u32 i = 0; i < m_Dependencies.size();)
+        {
+            Dependency & t_Dependency = m_Dependencies[i];
+            SceneObject * t_Shaded = t_Manager.GetSceneObject(t_Dependency.m_Shaded);
+            SceneObject * t_Opposing = t_Manager.GetSceneObject(t_Dependency.m_Opposing);
+            if (t_Shaded == nullptr || t_Opposing == nullptr)
+            {
+                t_Worker.Release(t_Dependency.m_Shaded, t_Dependency.m_Opposing);
+                t_Dependency = m_Dependencies.back();
+                m_Dependencies.pop_back();
+                continue;
+            }
+
+            u32 t_ShadedVersion = t_Shaded->GetTransformVersion();
+            u32 t_OpposingVersion = t_Opposing->GetTransformVersion();
+            if (!t_Dependency.m_Submitted ||
+                t_Dependency.m_ShadedVersion != t_ShadedVersion ||
+                t_Dependency.m_OpposingVersion != t_OpposingVersion ||
+                t_Dependency.m_MaxDistance != t_MaxDistance)
+            {
+                t_Worker.Submit(t_Dependency.m_Shaded, t_Dependency.m_Opposing, t_MaxDistance);
+                t_Dependency.m_ShadedVersion = t_ShadedVersion;
+                t_Dependency.m_OpposingVersion = t_OpposingVersion;
+                t_Dependency.m_MaxDistance = t_MaxDistance;
+                t_Dependency.m_Submitted = true;
+                ++t_Submitted;
+            }
+            ++i;
+        }
+
+        return t_Submitted;
+    }
+}
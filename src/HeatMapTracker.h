@@ -0,0 +1,57 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMapTracker.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _HEATMAPTRACKER_H_
+#define _HEATMAPTRACKER_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <vector>
+#include "SceneObjectManager.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Remembers what every heatmap result was computed from: the transform
+    // versions of its shaded and opposing objects and the search distance.
+    // Only results whose inputs changed since they were last submitted are
+    // handed to the HeatMapWorker, so moving one object recomputes the
+    // pairs it takes part in and nothing else. Pairs whose objects were
+    // removed are dropped, as their handles no longer resolve, and their
+    // worker slots are released.
+    class HeatMapTracker
+    {
+        public:
+
+            void    Clear();
+            void    Track(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing);
+            void    Invalidate();
+
+            // returns the number of results submitted
+            u32     SubmitInvalidated(f32 t_MaxDistance);
+
+        private:
+
+            struct Dependency
+            {
+                SceneObjectHandle   m_Shaded;
+                SceneObjectHandle   m_Opposing;
+                u32                 m_ShadedVersion;
+                u32                 m_OpposingVersion;
+                f32                 m_MaxDistance;
+                bool                m_Submitted;    // the versions above are meaningful
+            };
+
+            std::vector<Dependency>     m_Dependencies;
+    };
+}
+
+#endif
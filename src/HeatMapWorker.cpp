@@ -0,0 +1,326 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMapWorker.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <algorithm>
+#include "HeatMapWorker.h"
+#include "Model.h"
+#include "graphics.hpp"
+
+namespace Proto
+{
+    HeatMapWorker::Slot::Slot()
+        : m_Pending(false)
+        , m_Restart(false)
+        , m_Busy(false)
+        , m_Ready(false)
+        , m_Released(false)
+        , m_Cancelled(false)
+    {
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn HeatMapWorker & HeatMapWorker::GetInstance()
+
+    \brief
+        This function retrieves the instance of this class.
+    */
+    /*************************************************************************/
+    HeatMapWorker & HeatMapWorker::GetInstance()
+    {
+        static HeatMapWorker s_Instance;
+        return s_Instance;
+    }
+
+    HeatMapWorker::HeatMapWorker()
+        : m_Quit(false)
+        , m_Progressive(false)
+        , m_BudgetMs(0.f)
+        , m_Running(nullptr)
+    {
+    }
+
+    HeatMapWorker::~HeatMapWorker()
+    {
+        Shutdown();
+
+        for (SLOT_CONT::iterator t_Iter = m_Slots.begin(); t_Iter != m_Slots.end(); ++t_Iter)
+            delete t_Iter->second;
+        m_Slots.clear();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::Submit(SceneObjectHandle t_Shaded,
+                                   SceneObjectHandle t_Opposing,
+                                   f32 t_MaxDistance)
+
+    \brief
+        Requests a heatmap of t_Shaded against t_Opposing using their 
+        current transforms, searching up to t_MaxDistance. Supersedes any
+        earlier request of the same pair that has not been delivered yet.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::Submit(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing, f32 t_MaxDistance)
+    {
+        SceneObjectManager & t_Manager = SceneObjectManager::GetInstance();
+        HeatMapJob t_Job(t_Manager.GetSceneObject(t_Shaded), t_Manager.GetSceneObject(t_Opposing), t_MaxDistance);
+        if (!t_Job.IsValid())
+            return;
+
+        {
+            std::lock_guard<std::mutex> t_Lock(m_Mutex);
+
+            Slot *& t_Slot = m_Slots[SLOT_KEY(t_Shaded, t_Opposing)];
+            if (t_Slot == nullptr)
+                t_Slot = new Slot();
+
+            t_Slot->m_Job = t_Job;
+            t_Slot->m_Restart = true;
+
+            // the result in flight is already stale
+            if (t_Slot->m_Busy)
+                t_Slot->m_Cancelled = true;
+
+            if (!t_Slot->m_Pending)
+            {
+                t_Slot->m_Pending = true;
+                m_Queue.push_back(t_Slot);
+            }
+
+            if (!m_Thread.joinable())
+            {
+                m_Quit = false;
+                m_Thread = std::thread(&HeatMapWorker::Run, this);
+            }
+        }
+        m_Signal.notify_one();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::Release(SceneObjectHandle t_Shaded,
+                                    SceneObjectHandle t_Opposing)
+
+    \brief
+        Drops the slot of a pair and any result it has not delivered. A 
+        slot the worker is computing is cancelled and left for the worker 
+        to free.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::Release(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+
+        SLOT_CONT::iterator t_Iter = m_Slots.find(SLOT_KEY(t_Shaded, t_Opposing));
+        if (t_Iter == m_Slots.end())
+            return;
+
+        Slot * t_Slot = t_Iter->second;
+        m_Slots.erase(t_Iter);
+        if (t_Slot->m_Pending)
+            m_Queue.erase(std::find(m_Queue.begin(), m_Queue.end(), t_Slot));
+
+        if (t_Slot->m_Busy)
+        {
+            t_Slot->m_Released = true;
+            t_Slot->m_Cancelled = true;
+        }
+        else
+        {
+            delete t_Slot;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::UploadCompletedResults()
+
+    \brief
+        Called by the render thread once per frame. Swaps every completed
+        result into its shaded mesh and re-sends the heatmap stream.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::UploadCompletedResults()
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+
+        for (SLOT_CONT::iterator t_Iter = m_Slots.begin(); t_Iter != m_Slots.end(); ++t_Iter)
+        {
+            Slot& t_Slot = *t_Iter->second;
+            if (!t_Slot.m_Ready)
+                continue;
+
+            Mesh& t_Mesh = t_Slot.m_Job.m_ShadedModel->GetModelMesh();
+            if (t_Slot.m_Completed.size() == t_Mesh.heatmapBuffer.size())
+            {
+                // the mesh's previous buffer becomes the slot's spare
+                std::swap(t_Mesh.heatmapBuffer, t_Slot.m_Completed);
+                UpdateGPUHeatMap(t_Mesh);
+            }
+            t_Slot.m_Ready = false;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::Shutdown()
+
+    \brief
+        Stops the worker thread, abandoning the job in flight.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> t_Lock(m_Mutex);
+            m_Quit = true;
+            for (SLOT_CONT::iterator t_Iter = m_Slots.begin(); t_Iter != m_Slots.end(); ++t_Iter)
+                t_Iter->second->m_Cancelled = true;
+        }
+        m_Signal.notify_one();
+
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::SetProgressive(bool t_Progressive, f32 t_BudgetMs)
+
+    \brief
+        Selects between computing each job in one go and computing it in 
+        slices of t_BudgetMs milliseconds, delivering a preview after each.
+        Takes effect from the next slice.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::SetProgressive(bool t_Progressive, f32 t_BudgetMs)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        m_Progressive = t_Progressive;
+        m_BudgetMs = t_BudgetMs;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::CancelJobsOf(const Model * t_Model)
+
+    \brief
+        Marks every heatmap of t_Model as stale. The slice in flight is 
+        cancelled so that the worker lets go of the model's stream mutex
+        soon, and every affected slot is queued to start over.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::CancelJobsOf(const Model * t_Model)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+
+        if (m_Running && (m_RunningJob.m_ShadedModel == t_Model || m_RunningJob.m_OpposingModel == t_Model))
+        {
+            m_Running->m_Cancelled = true;
+            m_Running->m_Restart = true;
+            if (!m_Running->m_Pending && !m_Running->m_Released)
+            {
+                m_Running->m_Pending = true;
+                m_Queue.push_back(m_Running);
+            }
+        }
+
+        for (SLOT_CONT::iterator t_Iter = m_Slots.begin(); t_Iter != m_Slots.end(); ++t_Iter)
+        {
+            Slot& t_Slot = *t_Iter->second;
+            if (t_Slot.m_Job.m_ShadedModel != t_Model && t_Slot.m_Job.m_OpposingModel != t_Model)
+                continue;
+
+            t_Slot.m_Restart = true;
+            if (!t_Slot.m_Pending)
+            {
+                t_Slot.m_Pending = true;
+                m_Queue.push_back(&t_Slot);
+            }
+        }
+        if (!m_Queue.empty())
+            m_Signal.notify_one();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void HeatMapWorker::Run()
+
+    \brief
+        Worker thread loop. Takes the oldest pending slot, advances its 
+        latest job outside the lock, holding the stream mutex of its models
+        instead, and publishes the result unless it was superseded or its
+        models' streams are about to change.
+    */
+    /*************************************************************************/
+    void HeatMapWorker::Run()
+    {
+        std::unique_lock<std::mutex> t_Lock(m_Mutex);
+
+        while (true)
+        {
+            m_Signal.wait(t_Lock, [this]() { return m_Quit || !m_Queue.empty(); });
+            if (m_Quit)
+                return;
+
+            Slot& t_Slot = *m_Queue.front();
+            m_Queue.erase(m_Queue.begin());
+
+            HeatMapJob t_Job = t_Slot.m_Job;
+            bool t_Restart = t_Slot.m_Restart;
+            f32 t_BudgetMs = m_Progressive ? m_BudgetMs : 0.f;
+            t_Slot.m_Pending = false;
+            t_Slot.m_Restart = false;
+            t_Slot.m_Busy = true;
+            t_Slot.m_Cancelled = false;
+            m_Running = &t_Slot;
+            m_RunningJob = t_Job;
+
+            t_Lock.unlock();
+            bool t_Done;
+            {
+                //both models' streams stay as they are for the whole slice,
+                //a model may be both the shaded and the opposing one
+                std::unique_lock<std::mutex> t_ShadedStreams(t_Job.m_ShadedModel->GetStreamMutex(), std::defer_lock);
+                std::unique_lock<std::mutex> t_OpposingStreams(t_Job.m_OpposingModel->GetStreamMutex(), std::defer_lock);
+                if (t_Job.m_ShadedModel == t_Job.m_OpposingModel)
+                    t_ShadedStreams.lock();
+                else
+                    std::lock(t_ShadedStreams, t_OpposingStreams);
+
+                if (t_Restart)
+                    t_Slot.m_Progress.Begin(t_Job);
+                t_Done = t_Slot.m_Progress.Step(t_BudgetMs, &t_Slot.m_Cancelled);
+                if (!t_Slot.m_Cancelled)
+                    t_Slot.m_Progress.Resolve(t_Slot.m_Working);
+            }
+            t_Lock.lock();
+
+            t_Slot.m_Busy = false;
+            m_Running = nullptr;
+            m_RunningJob = HeatMapJob();
+            if (t_Slot.m_Released)
+            {
+                delete &t_Slot;
+                continue;
+            }
+            if (t_Slot.m_Cancelled)
+                continue;
+
+            std::swap(t_Slot.m_Working, t_Slot.m_Completed);
+            t_Slot.m_Ready = true;
+
+            //unfinished progressive jobs go to the back so every slot 
+            //gets its coarse preview first
+            if (!t_Done && !t_Slot.m_Pending)
+            {
+                t_Slot.m_Pending = true;
+                m_Queue.push_back(&t_Slot);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      HeatMapWorker.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _HEATMAPWORKER_H_
+#define _HEATMAPWORKER_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "HeatMap.h"
+#include "SceneObjectManager.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Computes heatmaps on a background thread.
+    // Each (shaded, opposing) pair of handles owns a slot; submitting a 
+    // pair again replaces its pending job and cancels the one in flight, so
+    // only the latest request is ever delivered. A pair's slot is freed by
+    // Release once either object is gone. Results are double buffered and 
+    // swapped into the shaded mesh by the render thread.
+    // In progressive mode a job runs in slices of the frame budget, slots 
+    // take turns, and every slice delivers an interpolated preview.
+    // A slice holds the stream mutex of both models, so the GL thread can
+    // not change their streams underneath it.
+    class HeatMapWorker
+    {
+        public:
+
+            static HeatMapWorker &  GetInstance();
+
+            void                Submit(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing, f32 t_MaxDistance);
+            void                Release(SceneObjectHandle t_Shaded, SceneObjectHandle t_Opposing);
+            void                UploadCompletedResults();
+            void                Shutdown();
+            void                SetProgressive(bool t_Progressive, f32 t_BudgetMs);
+
+            // call before changing the CPU streams of t_Model, then take its
+            // stream mutex; its jobs start over once the mutex is released
+            void                CancelJobsOf(const Model * t_Model);
+
+        private:
+
+            struct Slot
+            {
+                Slot();
+
+                HeatMapJob          m_Job;          // latest requested job
+                bool                m_Pending;      // the slot is queued and not picked up yet
+                bool                m_Restart;      // m_Job has not been started yet
+                bool                m_Busy;         // the worker is computing this slot
+                bool                m_Ready;        // m_Completed holds an unconsumed result
+                bool                m_Released;     // the pair is gone, freed by the worker once it is done with it
+                std::atomic<bool>   m_Cancelled;    // set when the job in flight is superseded
+                HeatMapBufferType   m_Working;      // written by the worker thread
+                HeatMapBufferType   m_Completed;    // last finished result
+                HeatMapProgress     m_Progress;     // only touched by the worker thread
+            };
+
+            typedef std::pair<SceneObjectHandle, SceneObjectHandle> SLOT_KEY;
+            typedef std::map<SLOT_KEY, Slot *>                      SLOT_CONT;
+
+            HeatMapWorker();
+            ~HeatMapWorker();
+            HeatMapWorker(const HeatMapWorker &);
+            HeatMapWorker & operator = (const HeatMapWorker &);
+
+            void                Run();
+
+            SLOT_CONT                   m_Slots;
+            std::vector<Slot *>         m_Queue;        // a handful of slots, kept as a vector so requeueing does not allocate
+            std::mutex                  m_Mutex;
+            std::condition_variable     m_Signal;
+            std::thread                 m_Thread;
+            bool                        m_Quit;
+            bool                        m_Progressive;
+            f32                         m_BudgetMs;
+            Slot *                      m_Running;      // slot the worker is computing, if any
+            HeatMapJob                  m_RunningJob;   // the job it is computing
+    };
+}
+
+#endif
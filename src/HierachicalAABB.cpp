@@ -21,7 +21,7 @@ HierachicalAABB::~HierachicalAABB()
 
 
 
-void HierachicalAABB::BuildFromModel(const VertexBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth)
+void HierachicalAABB::BuildFromModel(const PositionBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth)
 {
 	this->maxDepth = maxDepth;
 	//TODO: IMPLEMENT YOUR OWN MODEL PARSING ENTRY POINT
@@ -48,8 +48,23 @@ void HierachicalAABB::BuildFromModel(const VertexBufferType &pnts, const std::ve
             lowestDepthStartingIndex = tempSize;
         }
 
+        //a rebuild reuses the nodes, their index lists and the build scratch
         this->nodes.resize(size);
-        ConstructSubTree(pnts, indicies, &this->nodes[0], 0, maxDepth);
+        for (unsigned i = 0; i < size; ++i)
+        {
+            HierachicalAABBNode& node = this->nodes[i];
+            node.index = -1;
+            node.m_Parent = node.m_LeftChild = node.m_RightChild = -1;
+            node.depth = static_cast<u16>(-1);
+            node.collided = false;
+            node.indices.clear();
+            node.triangleIndices.clear();
+            node.triangleStart = node.triangleCount = 0;
+        }
+
+        m_BuildIndices.assign(indicies.begin(), indicies.begin() + indicies.size() - indicies.size() % 3);
+        m_BuildScratch.resize(m_BuildIndices.size());
+        ConstructSubTree(pnts, 0, m_BuildIndices.size(), &this->nodes[0], 0, maxDepth);
     }
 }
 
@@ -80,11 +95,105 @@ HierachicalAABB& HierachicalAABB::ApplyTransform(const mat4& mat, const Hierachi
     return *this;
 }
 
+//copies the boxes and links only, for trees that are only ever transformed
+void HierachicalAABB::CopyTopology(const HierachicalAABB& r)
+{
+	this->maxDepth = r.maxDepth;
+	this->lowestDepthStartingIndex = r.lowestDepthStartingIndex;
+
+	u32 total = r.nodes.size();
+	this->nodes.resize(total);
+	for (u32 i = 0; i < total; ++i)
+	{
+		const HierachicalAABBNode& src = r.nodes[i];
+		HierachicalAABBNode& node = this->nodes[i];
+		node.index = src.index;
+		node.m_Parent = src.m_Parent;
+		node.m_LeftChild = src.m_LeftChild;
+		node.m_RightChild = src.m_RightChild;
+		node.depth = src.depth;
+		node.collided = src.collided;
+		node.m_AABB = src.m_AABB;
+		node.triangleStart = src.triangleStart;
+		node.triangleCount = src.triangleCount;
+		std::vector<int>().swap(node.indices);
+		std::vector<std::array<int, 3>>().swap(node.triangleIndices);
+	}
+}
+
+//for trees that are built once, rebuilt trees keep the scratch
+void HierachicalAABB::ReleaseBuildScratch()
+{
+	std::vector<int>().swap(m_BuildIndices);
+	std::vector<int>().swap(m_BuildScratch);
+}
+
 u32 HierachicalAABB::getMaxDepth()
 {
 	return maxDepth;
 }
 
+//flattens the tree, leaf indices are appended leaf by leaf
+void HierachicalAABB::ExportRecords(std::vector<HierachicalAABBNodeRecord>& t_Nodes, std::vector<int>& t_LeafIndices, u32& t_MaxDepth) const
+{
+	t_Nodes.resize(nodes.size());
+	t_LeafIndices.clear();
+	t_MaxDepth = maxDepth;
+
+	for (u32 i = 0; i < nodes.size(); ++i)
+	{
+		const HierachicalAABBNode& node = nodes[i];
+		HierachicalAABBNodeRecord& record = t_Nodes[i];
+
+		record.index = node.index;
+		record.parent = node.m_Parent;
+		record.leftChild = node.m_LeftChild;
+		record.rightChild = node.m_RightChild;
+		record.depth = node.depth;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			record.center[axis] = node.m_AABB.m_Center[axis];
+			record.radius[axis] = node.m_AABB.m_Radius[axis];
+		}
+		record.indexStart = t_LeafIndices.size();
+		record.indexCount = node.indices.size();
+		t_LeafIndices.insert(t_LeafIndices.end(), node.indices.begin(), node.indices.end());
+	}
+}
+
+//rebuilds the tree from ExportRecords output without touching the mesh
+void HierachicalAABB::ImportRecords(const HierachicalAABBNodeRecord* t_Nodes, u32 t_NodeCount, const int* t_LeafIndices, u32 t_MaxDepth)
+{
+	maxDepth = t_MaxDepth;
+	lowestDepthStartingIndex = (maxDepth <= 1) ? 0 : (1u << (maxDepth - 1)) - 1;
+
+	nodes.clear();
+	nodes.resize(t_NodeCount);
+	for (u32 i = 0; i < t_NodeCount; ++i)
+	{
+		const HierachicalAABBNodeRecord& record = t_Nodes[i];
+		HierachicalAABBNode& node = nodes[i];
+
+		node.index = record.index;
+		node.m_Parent = record.parent;
+		node.m_LeftChild = record.leftChild;
+		node.m_RightChild = record.rightChild;
+		node.depth = static_cast<u16>(record.depth);
+		node.m_AABB.m_Center = vec3(record.center[0], record.center[1], record.center[2]);
+		node.m_AABB.m_Radius = vec3(record.radius[0], record.radius[1], record.radius[2]);
+
+		const int* first = t_LeafIndices + record.indexStart;
+		node.indices.assign(first, first + record.indexCount);
+		node.triangleIndices.resize(record.indexCount / 3);
+		for (u32 j = 0; j + 2 < record.indexCount; j += 3)
+		{
+			node.triangleIndices[j / 3][0] = first[j];
+			node.triangleIndices[j / 3][1] = first[j + 1];
+			node.triangleIndices[j / 3][2] = first[j + 2];
+		}
+	}
+}
+
 void HierachicalAABB::GetHalfLengthAndSort(
 	std::array<int, 3>& idxs,
 	std::array<float, 3>& lens,
@@ -112,12 +221,14 @@ void HierachicalAABB::GetHalfLengthAndSort(
 	}
 }
 
-void HierachicalAABB::SubDivideModelTriangles(
+//splits the triangles of m_BuildIndices[first, first + count) by their
+//barycenter, left side first, keeping their order. Returns the number of
+//left indices; 0 or count if no axis separates them.
+u32 HierachicalAABB::SubDivideModelTriangles(
 	const Proto::AABB& parentAABB
-	, const VertexBufferType &pnts		//vertex buffer
-	, const std::vector<int> &indicies	//index buffer
-	, std::vector<int>&leftIndices
-	, std::vector<int>&rightIndices)
+	, const PositionBufferType &pnts		//vertex buffer
+	, const u32 first
+	, const u32 count)
 {
 	//TODO : IMPLEMENT YOUR OWN CUSTOM TRIANGLE/VERTEX SPLITTING ALGORITHM
     //@MSMS:DONE
@@ -127,43 +238,42 @@ void HierachicalAABB::SubDivideModelTriangles(
 
 	GetHalfLengthAndSort(idxs, lens, parentAABB.m_Radius);
 
-	unsigned axisCount = 0;
-	std::vector<int> left, right;
+	int* indicies = &m_BuildIndices[first];
+	int* scratch = &m_BuildScratch[first];
 	float oneThird = 1 / 3.0f;
-	while (axisCount < 3 && (left.empty() || right.empty()))
+	u32 leftCount = 0;
+	for (unsigned axisCount = 0; axisCount < 3 && (leftCount == 0 || leftCount == count); ++axisCount)
 	{
-		left.clear();
-		right.clear();
+		//left triangles are packed forward in place, right ones go to the
+		//scratch and are appended after them
+		leftCount = 0;
+		u32 rightCount = 0;
 		const vec3 curAxis = axis[idxs[axisCount]];
-		for (int i = 0; i < indicies.size(); i+=3)
+		for (u32 i = 0; i < count; i += 3)
 		{
-			vec3 barycenter = (pnts[indicies[i]].pos + pnts[indicies[i+1]].pos + pnts[indicies[i+2]].pos) *oneThird;
+			int i0 = indicies[i], i1 = indicies[i + 1], i2 = indicies[i + 2];
+			vec3 barycenter = (pnts[i0] + pnts[i1] + pnts[i2]) *oneThird;
 			float dot = Dot(curAxis, barycenter - parentAABB.m_Center);
 
+			int* dst = (dot > 0.f) ? scratch + rightCount : indicies + leftCount;
+			dst[0] = i0;
+			dst[1] = i1;
+			dst[2] = i2;
 			if (dot > 0.f)
-			{
-				right.push_back(indicies[i]);
-				right.push_back(indicies[i+1]);
-				right.push_back(indicies[i+2]);
-			}
+				rightCount += 3;
 			else
-			{
-				left.push_back(indicies[i]);
-				left.push_back(indicies[i+1]);
-				left.push_back(indicies[i+2]);
-			}
+				leftCount += 3;
 		}
-		++axisCount;
+		std::copy(scratch, scratch + rightCount, indicies + leftCount);
 	}
 
-	std::swap(leftIndices, left);
-	std::swap(rightIndices, right);
-	return;
+	return leftCount;
 }
 
 
-void HierachicalAABB::ConstructSubTree(const VertexBufferType &pnts
-	, const std::vector<int> &indicies
+void HierachicalAABB::ConstructSubTree(const PositionBufferType &pnts
+	, const u32 first
+	, const u32 count
 	, HierachicalAABBNode* node
 	, const u32 parentIndex
 	, const u32 iterationCount)
@@ -173,20 +283,18 @@ void HierachicalAABB::ConstructSubTree(const VertexBufferType &pnts
 		return;
 
 	//create a node
-	Proto::AABB aabb;
-	aabb.Create(pnts, indicies);
-	node->m_AABB = aabb;
-	std::vector<int> lIndices, rIndicies;
+	const int* indicies = m_BuildIndices.empty() ? nullptr : &m_BuildIndices[first];
+	node->m_AABB.Create(pnts, indicies, count);
 	node->index = parentIndex;
 	node->depth = maxDepth - iterationCount;
 
     //TODO : IMPLEMENT YOUR OWN CUSTOM TREE CONSTRUCTION ALGORITHM
     //@MSMS:DONE
-	if (iterationCount > 1)
+	if (iterationCount > 1 && count)
     {
-        SubDivideModelTriangles(node->m_AABB, pnts, indicies, lIndices, rIndicies);
+        u32 leftCount = SubDivideModelTriangles(node->m_AABB, pnts, first, count);
 
-        if (!lIndices.empty() && !rIndicies.empty())
+        if (leftCount != 0 && leftCount != count)
         {
             //set current node child index
             node->m_LeftChild = (parentIndex + 1) * 2 - 1;
@@ -196,30 +304,19 @@ void HierachicalAABB::ConstructSubTree(const VertexBufferType &pnts
             this->nodes[node->m_RightChild].m_Parent = parentIndex;
 
             //recursively build subtree for left and right
-            //ConstructSubTree(pnts, indicies, &this->nodes[0], 0, maxDepth);
-            ConstructSubTree(pnts, lIndices, &this->nodes[node->m_LeftChild], node->m_LeftChild, iterationCount - 1);
-            ConstructSubTree(pnts, rIndicies, &this->nodes[node->m_RightChild], node->m_RightChild, iterationCount - 1);
+            ConstructSubTree(pnts, first, leftCount, &this->nodes[node->m_LeftChild], node->m_LeftChild, iterationCount - 1);
+            ConstructSubTree(pnts, first + leftCount, count - leftCount, &this->nodes[node->m_RightChild], node->m_RightChild, iterationCount - 1);
+            return;
         }
 	}
 
-    return;	
-	/*
-
-    node->indices = indicies;
-    u32 total = node->indices.size();
-    node->triangleIndices.resize(total / 3);
-    for (u32 i = 0; i < total; i += 3)
+    //leaf node, keep its triangles for ray queries
+    node->indices.assign(indicies, indicies + count);
+    node->triangleIndices.resize(count / 3);
+    for (u32 i = 0; i < count; i += 3)
     {
-    u32 i0, i1, i2;
-    i0 = node->indices[i];
-    i1 = node->indices[i + 1];
-    i2 = node->indices[i + 2];
-    node->triangleIndices[i / 3][0] = i0;
-    node->triangleIndices[i / 3][1] = i1;
-    node->triangleIndices[i / 3][2] = i2;
+        node->triangleIndices[i / 3][0] = indicies[i];
+        node->triangleIndices[i / 3][1] = indicies[i + 1];
+        node->triangleIndices[i / 3][2] = indicies[i + 2];
     }
-    */	
 }
-
-
-
@@ -18,6 +18,8 @@ struct HierachicalAABBNode
 		, m_RightChild(-1)
 		, depth(-1)
 		, collided(false)
+		, triangleStart(0)
+		, triangleCount(0)
 	{}
 
 
@@ -31,6 +33,8 @@ struct HierachicalAABBNode
 		, m_AABB(r.m_AABB)
 		, indices(r.indices)
 		, triangleIndices(r.triangleIndices)
+		, triangleStart(r.triangleStart)
+		, triangleCount(r.triangleCount)
 	{}
 
 	bool collided;
@@ -42,7 +46,26 @@ struct HierachicalAABBNode
 	Proto::AABB m_AABB;
 	std::vector<int> indices;
 	std::vector<std::array<int,3>> triangleIndices;
+	//range of this leaf in the model's TriangleRecords
+	u32 triangleStart;
+	u32 triangleCount;
 };
+
+// pointer-free copy of a node, as stored in the .msb mesh cache
+struct HierachicalAABBNodeRecord
+{
+	s32 index;
+	s32 parent;
+	s32 leftChild;
+	s32 rightChild;
+	u32 depth;
+	f32 center[3];
+	f32 radius[3];
+	//range of a leaf's indices in the flat leaf index array
+	u32 indexStart;
+	u32 indexCount;
+};
+
 typedef void(*VisitorFunc)(const HierachicalAABBNode& node);
 typedef bool(*TraversalCheckFunc)(const HierachicalAABBNode& node);
 
@@ -52,12 +75,14 @@ public:
 	HierachicalAABB();
 	HierachicalAABB(const HierachicalAABB&);
 	~HierachicalAABB();
-	void BuildFromModel(const VertexBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth = 1);
+	void BuildFromModel(const PositionBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth = 1);
 	HierachicalAABB& operator = (const HierachicalAABB&);
     HierachicalAABB& ApplyTransform(const mat4& mat, const HierachicalAABB& t_ModelSpaceSource);
+	void CopyTopology(const HierachicalAABB& r);
+	void ReleaseBuildScratch();
 
 	template< typename T1, typename T2>
-	void VisitNodes(T1& v, T2& c)
+	void VisitNodes(T1& v, T2& c) const
 	{
 		if (!nodes.empty())
 			CheckSubTree(nodes[0], v, c);
@@ -72,10 +97,16 @@ public:
 
 	u32 getMaxDepth();
 
+	void ExportRecords(std::vector<HierachicalAABBNodeRecord>& t_Nodes, std::vector<int>& t_LeafIndices, u32& t_MaxDepth) const;
+	void ImportRecords(const HierachicalAABBNodeRecord* t_Nodes, u32 t_NodeCount, const int* t_LeafIndices, u32 t_MaxDepth);
+
 private:
 	u32 maxDepth;
-	void SubDivideModelTriangles(const Proto::AABB& parentAABB, const VertexBufferType &pnts, const std::vector<int> &indicies, std::vector<int>&leftIndices, std::vector<int>&rightIndices);
-	void ConstructSubTree(const VertexBufferType &pnts, const std::vector<int> &indicies, HierachicalAABBNode*, const u32 parentIndex, const u32 iterationCount);
+	//build scratch, the index buffer partitioned in place and kept between builds
+	std::vector<int> m_BuildIndices;
+	std::vector<int> m_BuildScratch;
+	u32 SubDivideModelTriangles(const Proto::AABB& parentAABB, const PositionBufferType &pnts, const u32 first, const u32 count);
+	void ConstructSubTree(const PositionBufferType &pnts, const u32 first, const u32 count, HierachicalAABBNode*, const u32 parentIndex, const u32 iterationCount);
 
 	//my helper functions
 	void GetHalfLengthAndSort(std::array<int, 3>& idxs, std::array<float, 3>& lens, const vec3& radius);
@@ -91,7 +122,7 @@ private:
 	}
 
 	template< typename T1, typename T2>
-	void CheckSubTree(const HierachicalAABBNode& node, T1& visitor, T2& IsInPartition)
+	void CheckSubTree(const HierachicalAABBNode& node, T1& visitor, T2& IsInPartition) const
 	{
 
 
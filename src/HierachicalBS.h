@@ -32,7 +32,7 @@ public:
 	HierachicalBS();
 	HierachicalBS(const HierachicalBS&);
 	~HierachicalBS();
-	void BuildFromModel(const VertexBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth = 7);
+	void BuildFromModel(const PositionBufferType &pnts, const std::vector<int> &indicies, const u32 maxDepth = 7);
 	HierachicalBS& operator = (const HierachicalBS&);
 	HierachicalBS& ApplyTransform(const vec3 &  t_translationVec, const vec3& t_ScaleVec, const vec3& t_RotVec, const HierachicalBS& t_ModelSpaceSource);
 
@@ -0,0 +1,50 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      IBroadphase.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _IBROADPHASE_H_
+#define _IBROADPHASE_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <vector>
+#include "AABB.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // (smaller id, larger id) of two boxes that overlap
+    typedef std::pair<u32, u32>         BroadphasePair;
+    typedef std::vector<BroadphasePair> BroadphasePairs;
+
+    struct BroadphaseType
+    {
+        enum { SWEEP_AND_PRUNE = 0, SPATIAL_HASH, NUM_BROADPHASES };
+    };
+
+    // Finds the pairs of world-space boxes that overlap. Ids are chosen by
+    // the caller and should be small (they index a table).
+    class IBroadphase
+    {
+        public:
+
+            virtual ~IBroadphase() {}
+
+            virtual void                    Add(u32 t_Id, const AABB & t_Box) = 0;
+            virtual void                    Remove(u32 t_Id) = 0;
+            virtual void                    Update(u32 t_Id, const AABB & t_Box) = 0;
+            virtual void                    Clear() = 0;
+
+            // every overlapping pair exactly once, valid until the next call
+            virtual const BroadphasePairs & FindPairs() = 0;
+    };
+}
+
+#endif
@@ -6,15 +6,21 @@ Creation Date:  24/Sep/2016
 #ifndef I_SCENE_GRAPH
 #define	I_SCENE_GRAPH
 #include "math.hpp"
-class SceneObject;
+namespace Proto
+{
+	class SceneObject;
+}
 
 class ISceneGraph
 {
 public:
 	//ISceneGraph(){};
 	virtual ~ISceneGraph(){};
-	virtual SceneObject* GetClosestObject(const vec3& origin, const vec3& ray, float& timeOfIntersection) = 0;
-	virtual SceneObject* GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, float& timeOfIntersection) = 0;
-	virtual void InsertObject(SceneObject *pObject) = 0;
+	virtual Proto::SceneObject* GetClosestObject(const vec3& origin, const vec3& ray, float& timeOfIntersection) = 0;
+	virtual Proto::SceneObject* GetClosestOccluder(const vec3& origin, const vec3& ray, const f32 lightDistance, float& timeOfIntersection) = 0;
+	virtual void InsertObject(Proto::SceneObject *pObject) = 0;
+	virtual void RemoveObject(Proto::SceneObject *pObject) = 0;
+	// called after the object has moved, so its bounds can be refreshed
+	virtual void UpdateObject(Proto::SceneObject *pObject) = 0;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,272 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      InstanceBatches.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <algorithm>
+#include "InstanceBatches.h"
+#include "graphics.hpp"
+#include "Model.h"
+
+namespace Proto
+{
+    InstanceBatches::InstanceBatches()
+        : m_DrawCount(0)
+    {
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void InstanceBatches::Add(u32 t_Id, Model * t_Model, s32 t_TextureID,
+                                  const mat4 & t_ModelMatrix, const vec3 & t_Color)
+
+    \brief
+        Appends the object to the group of its model and texture, creating
+        the group on first use. An id already added is moved, or dropped if
+        t_Model is null.
+    */
+    /*************************************************************************/
+    void InstanceBatches::Add(u32 t_Id, Model * t_Model, s32 t_TextureID, const mat4 & t_ModelMatrix, const vec3 & t_Color)
+    {
+        if (t_Id >= m_IdBatch.size())
+        {
+            m_IdBatch.resize(t_Id + 1, -1);
+            m_IdIndex.resize(t_Id + 1, 0);
+        }
+        Remove(t_Id);
+
+        if (!t_Model)
+            return;
+
+        s32 t_BatchIndex = -1;
+        for (u32 i = 0; i < m_Batches.size() && t_BatchIndex == -1; ++i)
+        {
+            if (m_Batches[i].m_Model == t_Model && m_Batches[i].m_TextureID == t_TextureID)
+                t_BatchIndex = i;
+        }
+        if (t_BatchIndex == -1)
+        {
+            Batch t_Batch;
+            t_Batch.m_Model = t_Model;
+            t_Batch.m_TextureID = t_TextureID;
+            t_Batch.m_DirtyBegin = 0;
+            t_Batch.m_DirtyEnd = 0;
+            t_Batch.m_Capacity = 0;
+            t_Batch.m_VBO = 0;
+            t_BatchIndex = m_Batches.size();
+            m_Batches.push_back(t_Batch);
+        }
+
+        Batch & t_Batch = m_Batches[t_BatchIndex];
+        InstanceData t_Instance;
+        SetInstance(t_Instance, t_ModelMatrix);
+        t_Instance.color = t_Color;
+
+        m_IdBatch[t_Id] = t_BatchIndex;
+        m_IdIndex[t_Id] = t_Batch.m_Instances.size();
+        t_Batch.m_Instances.push_back(t_Instance);
+        t_Batch.m_Ids.push_back(t_Id);
+        MarkDirty(t_Batch, m_IdIndex[t_Id]);
+    }
+
+    void InstanceBatches::Remove(u32 t_Id)
+    {
+        if (t_Id >= m_IdBatch.size() || m_IdBatch[t_Id] == -1)
+            return;
+
+        Batch & t_Batch = m_Batches[m_IdBatch[t_Id]];
+        u32 t_Index = m_IdIndex[t_Id];
+        u32 t_Last = t_Batch.m_Instances.size() - 1;
+        if (t_Index != t_Last)
+        {
+            t_Batch.m_Instances[t_Index] = t_Batch.m_Instances[t_Last];
+            t_Batch.m_Ids[t_Index] = t_Batch.m_Ids[t_Last];
+            m_IdIndex[t_Batch.m_Ids[t_Index]] = t_Index;
+            MarkDirty(t_Batch, t_Index);
+        }
+        t_Batch.m_Instances.pop_back();
+        t_Batch.m_Ids.pop_back();
+        m_IdBatch[t_Id] = -1;
+    }
+
+    void InstanceBatches::Update(u32 t_Id, const mat4 & t_ModelMatrix)
+    {
+        if (t_Id >= m_IdBatch.size() || m_IdBatch[t_Id] == -1)
+            return;
+
+        Batch & t_Batch = m_Batches[m_IdBatch[t_Id]];
+        SetInstance(t_Batch.m_Instances[m_IdIndex[t_Id]], t_ModelMatrix);
+        MarkDirty(t_Batch, m_IdIndex[t_Id]);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void InstanceBatches::Refresh(u32 t_Id, Model * t_Model, s32 t_TextureID,
+                                      const mat4 & t_ModelMatrix, const vec3 & t_Color)
+
+    \brief
+        Keeps the group of an object in step with its renderer. The group is
+        only chosen on Add, so an object whose model or texture is changed
+        later is moved here; an object without a model leaves its group.
+    */
+    /*************************************************************************/
+    void InstanceBatches::Refresh(u32 t_Id, Model * t_Model, s32 t_TextureID, const mat4 & t_ModelMatrix, const vec3 & t_Color)
+    {
+        if (t_Id >= m_IdBatch.size() || m_IdBatch[t_Id] == -1)
+        {
+            Add(t_Id, t_Model, t_TextureID, t_ModelMatrix, t_Color);
+            return;
+        }
+
+        Batch & t_Batch = m_Batches[m_IdBatch[t_Id]];
+        if (t_Batch.m_Model != t_Model || t_Batch.m_TextureID != t_TextureID)
+        {
+            Add(t_Id, t_Model, t_TextureID, t_ModelMatrix, t_Color);
+            return;
+        }
+
+        InstanceData & t_Instance = t_Batch.m_Instances[m_IdIndex[t_Id]];
+        if (t_Instance.color != t_Color)
+        {
+            t_Instance.color = t_Color;
+            MarkDirty(t_Batch, m_IdIndex[t_Id]);
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void InstanceBatches::Upload()
+
+    \brief
+        Re-sends the changed range of every group. A group that outgrew its
+        buffer gets a new one, sized to the CPU side capacity so that it
+        does not grow again on every add.
+    */
+    /*************************************************************************/
+    void InstanceBatches::Upload()
+    {
+        for (u32 i = 0; i < m_Batches.size(); ++i)
+        {
+            Batch & t_Batch = m_Batches[i];
+            u32 t_Count = t_Batch.m_Instances.size();
+            u32 t_End = std::min(t_Batch.m_DirtyEnd, t_Count);
+            if (t_Batch.m_DirtyBegin >= t_End)
+                continue;
+
+            if (!t_Batch.m_VBO)
+                glGenBuffers(1, &t_Batch.m_VBO);
+            glBindBuffer(GL_ARRAY_BUFFER, t_Batch.m_VBO);
+
+            if (t_Count > t_Batch.m_Capacity)
+            {
+                t_Batch.m_Capacity = t_Batch.m_Instances.capacity();
+                glBufferData(GL_ARRAY_BUFFER, t_Batch.m_Capacity * instanceSize, nullptr, GL_DYNAMIC_DRAW);
+                t_Batch.m_DirtyBegin = 0;
+                t_End = t_Count;
+            }
+
+            glBufferSubData(GL_ARRAY_BUFFER, t_Batch.m_DirtyBegin * instanceSize,
+                            (t_End - t_Batch.m_DirtyBegin) * instanceSize, &t_Batch.m_Instances[t_Batch.m_DirtyBegin]);
+            t_Batch.m_DirtyBegin = t_Batch.m_DirtyEnd = 0;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void InstanceBatches::Draw(const mat4 & t_ViewMatrix, bool t_Wireframe,
+                                   const std::vector<u8> & t_Visible)
+
+    \brief
+        Draws every group with the per instance transforms, the view matrix
+        is sent once for all of them. The LOD of each instance is picked as
+        in GFXComponent::Draw, and a run ends wherever the LOD changes or an
+        instance is not visible.
+    */
+    /*************************************************************************/
+    void InstanceBatches::Draw(const mat4 & t_ViewMatrix, bool t_Wireframe, const std::vector<u8> & t_Visible)
+    {
+        m_DrawCount = 0;
+        glUniform1i(instancingOnLoc, true);
+        glUniformMatrix4fv(mainViewMatLoc, 1, GL_FALSE, &t_ViewMatrix[0][0]);
+
+        for (u32 i = 0; i < m_Batches.size(); ++i)
+        {
+            const Batch & t_Batch = m_Batches[i];
+            u32 t_Count = t_Batch.m_Instances.size();
+            if (!t_Count || !t_Batch.m_VBO)
+                continue;
+
+            if (t_Wireframe || t_Batch.m_TextureID == -1)
+            {
+                glUniform1i(textureOnLoc, false);
+            }
+            else
+            {
+                glUniform1i(textureOnLoc, true);
+                SendObjTexID(t_Batch.m_TextureID, ActiveTexID::COLOR, textureLoc);
+            }
+
+            const Mesh & t_Mesh = t_Batch.m_Model->GetModelMesh();
+            const BS & t_BS = t_Batch.m_Model->GetBS();
+            u32 t_First = 0, t_RunLength = 0;
+            s32 t_RunLOD = -1;
+            for (u32 j = 0; j <= t_Count; ++j)
+            {
+                u32 t_Id = (j < t_Count) ? t_Batch.m_Ids[j] : 0;
+                bool t_IsVisible = j < t_Count && t_Id < t_Visible.size() && t_Visible[t_Id];
+                s32 t_LOD = -1;
+                if (t_IsVisible && !t_Wireframe)
+                    t_LOD = SelectMeshLOD(t_Mesh, t_BS.m_Center, t_BS.m_Radius, t_ViewMatrix * t_Batch.m_Instances[j].modelMat);
+
+                if (t_RunLength && (!t_IsVisible || t_LOD != t_RunLOD))
+                {
+                    BindInstanceStream(t_Mesh, t_Batch.m_VBO, t_First);
+                    RenderMeshObj(t_Mesh, t_Wireframe, t_RunLOD, t_RunLength);
+                    ++m_DrawCount;
+                    t_RunLength = 0;
+                }
+                if (t_IsVisible)
+                {
+                    if (!t_RunLength)
+                    {
+                        t_First = j;
+                        t_RunLOD = t_LOD;
+                    }
+                    ++t_RunLength;
+                }
+            }
+            UnbindInstanceStream(t_Mesh);
+        }
+
+        //plain draws after this one (the debug volumes) use uOutColor
+        glUniform1i(instancingOnLoc, false);
+        glUniform1i(textureOnLoc, false);
+    }
+
+    u32 InstanceBatches::GetDrawCount() const
+    {
+        return m_DrawCount;
+    }
+
+    void InstanceBatches::SetInstance(InstanceData & t_Instance, const mat4 & t_ModelMatrix)
+    {
+        Mat3 t_NormalMatrix = glm::transpose(glm::inverse(Mat3(t_ModelMatrix)));
+        t_Instance.modelMat = t_ModelMatrix;
+        for (u32 i = 0; i < 3; ++i)
+            t_Instance.normalMat[i] = t_NormalMatrix[i];
+    }
+
+    void InstanceBatches::MarkDirty(Batch & t_Batch, u32 t_Index)
+    {
+        if (t_Batch.m_DirtyBegin >= t_Batch.m_DirtyEnd)
+        {
+            t_Batch.m_DirtyBegin = t_Index;
+            t_Batch.m_DirtyEnd = t_Index + 1;
+            return;
+        }
+        t_Batch.m_DirtyBegin = std::min(t_Batch.m_DirtyBegin, t_Index);
+        t_Batch.m_DirtyEnd = std::max(t_Batch.m_DirtyEnd, t_Index + 1);
+    }
+}
@@ -0,0 +1,80 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      InstanceBatches.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _INSTANCEBATCHES_H_
+#define _INSTANCEBATCHES_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <vector>
+#include "mesh.hpp"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    class Model;
+
+    // Groups the objects sharing a model and a colour texture so that each
+    // group is drawn with instanced draws. Every group keeps its instances
+    // in one GPU buffer, and only the range of instances changed since the
+    // last Upload is re-sent. Removal moves the last instance of the group
+    // into the freed place.
+    // Instances are drawn in runs of consecutive visible instances at the
+    // same LOD, one instanced draw per run; a fully visible group at one
+    // LOD is a single draw.
+    class InstanceBatches
+    {
+        public:
+
+            InstanceBatches();
+
+            // t_Id is any small index unique per object, the handle slot
+            void        Add(u32 t_Id, Model * t_Model, s32 t_TextureID, const mat4 & t_ModelMatrix, const vec3 & t_Color);
+            void        Remove(u32 t_Id);
+            void        Update(u32 t_Id, const mat4 & t_ModelMatrix);
+
+            // moves t_Id to the group of its current model and texture if
+            // either changed since it was added, and picks up its colour
+            void        Refresh(u32 t_Id, Model * t_Model, s32 t_TextureID, const mat4 & t_ModelMatrix, const vec3 & t_Color);
+
+            // sends the changed instances of every group to the GPU
+            void        Upload();
+
+            // t_Visible is indexed by id, ids marked 0 are skipped
+            void        Draw(const mat4 & t_ViewMatrix, bool t_Wireframe, const std::vector<u8> & t_Visible);
+
+            u32         GetDrawCount() const;   // instanced draws issued by the last Draw
+
+        private:
+
+            struct Batch
+            {
+                Model *                     m_Model;
+                s32                         m_TextureID;
+                std::vector<InstanceData>   m_Instances;
+                std::vector<u32>            m_Ids;
+                u32                         m_DirtyBegin;   // [m_DirtyBegin, m_DirtyEnd) needs uploading
+                u32                         m_DirtyEnd;
+                u32                         m_Capacity;     // instances the GPU buffer holds
+                GLuint                      m_VBO;
+            };
+
+            static void SetInstance(InstanceData & t_Instance, const mat4 & t_ModelMatrix);
+            static void MarkDirty(Batch & t_Batch, u32 t_Index);
+
+            std::vector<Batch>  m_Batches;
+            std::vector<s32>    m_IdBatch;      // batch of each id, -1 for none
+            std::vector<u32>    m_IdIndex;      // instance of each id in its batch
+            u32                 m_DrawCount;
+    };
+}
+
+#endif
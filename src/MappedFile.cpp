@@ -0,0 +1,146 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MappedFile.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Proto
+{
+    MappedFile::MappedFile()
+        : m_Data(nullptr)
+        , m_Size(0)
+#ifdef _WIN32
+        , m_File(INVALID_HANDLE_VALUE)
+        , m_Mapping(nullptr)
+#else
+        , m_File(-1)
+#endif
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool MappedFile::Open(const str & t_FileName)
+
+    \brief
+        Maps the whole file read-only. Any previous view is closed first.
+
+    \return
+        false if the file does not exist, is empty or cannot be mapped.
+    */
+    /*************************************************************************/
+    bool MappedFile::Open(const str & t_FileName)
+    {
+        Close();
+
+#ifdef _WIN32
+        m_File = CreateFileA(t_FileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER t_Size;
+        if (!GetFileSizeEx(m_File, &t_Size) || t_Size.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_Mapping == nullptr)
+        {
+            Close();
+            return false;
+        }
+
+        m_Data = static_cast<const u8 *>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        m_Size = t_Size.QuadPart;
+#else
+        m_File = open(t_FileName.c_str(), O_RDONLY);
+        if (m_File == -1)
+            return false;
+
+        struct stat t_Stat;
+        if (fstat(m_File, &t_Stat) != 0 || t_Stat.st_size == 0)
+        {
+            Close();
+            return false;
+        }
+
+        void * t_View = mmap(nullptr, t_Stat.st_size, PROT_READ, MAP_PRIVATE, m_File, 0);
+        m_Data = (t_View == MAP_FAILED) ? nullptr : static_cast<const u8 *>(t_View);
+        m_Size = t_Stat.st_size;
+#endif
+
+        if (m_Data == nullptr)
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void MappedFile::Close()
+
+    \brief
+        Unmaps the view and closes the file.
+    */
+    /*************************************************************************/
+    void MappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping)
+            CloseHandle(m_Mapping);
+        if (m_File != INVALID_HANDLE_VALUE)
+            CloseHandle(m_File);
+
+        m_Mapping = nullptr;
+        m_File = INVALID_HANDLE_VALUE;
+#else
+        if (m_Data)
+            munmap(const_cast<u8 *>(m_Data), m_Size);
+        if (m_File != -1)
+            close(m_File);
+
+        m_File = -1;
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+    const u8 * MappedFile::GetData() const
+    {
+        return m_Data;
+    }
+
+    u64 MappedFile::GetSize() const
+    {
+        return m_Size;
+    }
+}
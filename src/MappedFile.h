@@ -0,0 +1,53 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MappedFile.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Defines.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Read-only view of a whole file mapped into memory.
+    // The view stays valid until Close() or destruction.
+    class MappedFile
+    {
+        public:
+
+            MappedFile();
+            ~MappedFile();
+
+            bool            Open(const str & t_FileName);
+            void            Close();
+
+            const u8 *      GetData() const;
+            u64             GetSize() const;
+
+        private:
+
+            MappedFile(const MappedFile &);
+            MappedFile & operator = (const MappedFile &);
+
+            const u8 *      m_Data;
+            u64             m_Size;
+#ifdef _WIN32
+            void *          m_File;
+            void *          m_Mapping;
+#else
+            int             m_File;
+#endif
+    };
+}
+
+#endif
@@ -0,0 +1,251 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshBinary.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <fstream>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "MeshBinary.h"
+#include "MappedFile.h"
+
+namespace Proto
+{
+    static const char s_MeshBinaryMagic[4] = { 'M', 'S', 'B', '1' };
+
+    // size and modification time of a file, false if it cannot be found
+    static bool GetFileStamp(const str & t_FileName, u64 & t_Size, u64 & t_Time)
+    {
+        struct stat t_Stat;
+        if (stat(t_FileName.c_str(), &t_Stat) != 0)
+            return false;
+        t_Size = static_cast<u64>(t_Stat.st_size);
+        t_Time = static_cast<u64>(t_Stat.st_mtime);
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool WriteMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                             const Mesh & t_Mesh, const HierachicalAABB & t_Tree,
+                             const AABB & t_AABB, const BS & t_BS)
+
+    \brief
+        Writes the mesh, its bounds and its AABB tree as a .msb file,
+        stamped with the size and modification time of t_SourceFileName.
+
+    \return
+        false if the file could not be written.
+    */
+    /*************************************************************************/
+    bool WriteMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                         const Mesh & t_Mesh, const HierachicalAABB & t_Tree,
+                         const AABB & t_AABB, const BS & t_BS)
+    {
+        std::vector<HierachicalAABBNodeRecord> t_Nodes;
+        std::vector<int> t_LeafIndices;
+
+        MeshBinaryHeader t_Header;
+        memcpy(t_Header.m_Magic, s_MeshBinaryMagic, sizeof(t_Header.m_Magic));
+        t_Header.m_Version      = MESH_BINARY_VERSION;
+        t_Header.m_VertexSize   = sizeof(Vertex);
+        t_Header.m_NodeSize     = sizeof(HierachicalAABBNodeRecord);
+        if (!GetFileStamp(t_SourceFileName, t_Header.m_SourceSize, t_Header.m_SourceTime))
+            return false;
+
+        t_Tree.ExportRecords(t_Nodes, t_LeafIndices, t_Header.m_TreeMaxDepth);
+
+        t_Header.m_VertexCount      = t_Mesh.vertexBuffer.size();
+        t_Header.m_IndexCount       = t_Mesh.indexBuffer.size();
+        t_Header.m_NodeCount        = t_Nodes.size();
+        t_Header.m_LeafIndexCount   = t_LeafIndices.size();
+        t_Header.m_PartCount        = t_Mesh.parts.size();
+
+        std::vector<MeshBinaryLOD> t_LODs(t_Mesh.lods.size());
+        MeshPartBufferType t_LODParts;
+        for (u32 i = 0; i < t_LODs.size(); ++i)
+        {
+            if (t_Mesh.lods[i].vertexRemap.size() != t_Mesh.vertexBuffer.size())
+                return false;
+            t_LODs[i].m_Error       = t_Mesh.lods[i].error;
+            t_LODs[i].m_PartStart   = t_LODParts.size();
+            t_LODs[i].m_PartCount   = t_Mesh.lods[i].parts.size();
+            t_LODParts.insert(t_LODParts.end(), t_Mesh.lods[i].parts.begin(), t_Mesh.lods[i].parts.end());
+        }
+        t_Header.m_LODCount         = t_LODs.size();
+        t_Header.m_LODIndexCount    = t_Mesh.lodIndexBuffer.size();
+        t_Header.m_LODPartCount     = t_LODParts.size();
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            t_Header.m_AABBCenter[axis] = t_AABB.m_Center[axis];
+            t_Header.m_AABBRadius[axis] = t_AABB.m_Radius[axis];
+            t_Header.m_BSCenter[axis]   = t_BS.m_Center[axis];
+        }
+        t_Header.m_BSRadius = t_BS.m_Radius;
+
+        std::ofstream t_File(t_FileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!t_File.is_open())
+            return false;
+
+        t_File.write(reinterpret_cast<const char *>(&t_Header), sizeof(t_Header));
+        if (!t_Mesh.vertexBuffer.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.vertexBuffer[0]), t_Header.m_VertexCount * sizeof(Vertex));
+        if (!t_Mesh.indexBuffer.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.indexBuffer[0]), t_Header.m_IndexCount * sizeof(int));
+        if (!t_Nodes.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Nodes[0]), t_Header.m_NodeCount * sizeof(HierachicalAABBNodeRecord));
+        if (!t_LeafIndices.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_LeafIndices[0]), t_Header.m_LeafIndexCount * sizeof(int));
+        if (!t_Mesh.parts.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.parts[0]), t_Header.m_PartCount * sizeof(MeshPart));
+        if (!t_Mesh.lodIndexBuffer.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.lodIndexBuffer[0]), t_Header.m_LODIndexCount * sizeof(int));
+        if (!t_LODs.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_LODs[0]), t_Header.m_LODCount * sizeof(MeshBinaryLOD));
+        if (!t_LODParts.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_LODParts[0]), t_Header.m_LODPartCount * sizeof(MeshPart));
+        for (u32 i = 0; i < t_Mesh.lods.size(); ++i)
+        {
+            if (t_Header.m_VertexCount)
+                t_File.write(reinterpret_cast<const char *>(&t_Mesh.lods[i].vertexRemap[0]), t_Header.m_VertexCount * sizeof(u32));
+        }
+
+        return t_File.good();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool ReadMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                            Mesh & t_Mesh, HierachicalAABB & t_Tree,
+                            AABB & t_AABB, BS & t_BS)
+
+    \brief
+        Maps a .msb file and fills the mesh, tree and bounds straight from 
+        the mapped sections. Nothing is parsed: each section is one block
+        copy into the owning container.
+        If t_SourceFileName exists, its size and modification time have to
+        match the ones the cache was written from.
+
+    \return
+        false if the file is missing, stale, truncated or refers to vertices
+        it does not hold; the outputs are left untouched in that case.
+    */
+    /*************************************************************************/
+    bool ReadMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                        Mesh & t_Mesh, HierachicalAABB & t_Tree,
+                        AABB & t_AABB, BS & t_BS)
+    {
+        MappedFile t_File;
+        if (!t_File.Open(t_FileName) || t_File.GetSize() < sizeof(MeshBinaryHeader))
+            return false;
+
+        const u8 * t_Data = t_File.GetData();
+        const MeshBinaryHeader & t_Header = *reinterpret_cast<const MeshBinaryHeader *>(t_Data);
+
+        if (memcmp(t_Header.m_Magic, s_MeshBinaryMagic, sizeof(t_Header.m_Magic)) != 0 ||
+            t_Header.m_Version != MESH_BINARY_VERSION ||
+            t_Header.m_VertexSize != sizeof(Vertex) ||
+            t_Header.m_NodeSize != sizeof(HierachicalAABBNodeRecord))
+            return false;
+
+        // without the source there is nothing to fall back to, so the cache
+        // is only checked against it when it is there
+        u64 t_SourceSize, t_SourceTime;
+        if (GetFileStamp(t_SourceFileName, t_SourceSize, t_SourceTime) &&
+            (t_SourceSize != t_Header.m_SourceSize || t_SourceTime != t_Header.m_SourceTime))
+            return false;
+
+        u64 t_VertexOffset  = sizeof(MeshBinaryHeader);
+        u64 t_IndexOffset   = t_VertexOffset + u64(t_Header.m_VertexCount) * sizeof(Vertex);
+        u64 t_NodeOffset    = t_IndexOffset + u64(t_Header.m_IndexCount) * sizeof(int);
+        u64 t_LeafOffset    = t_NodeOffset + u64(t_Header.m_NodeCount) * sizeof(HierachicalAABBNodeRecord);
+        u64 t_PartOffset    = t_LeafOffset + u64(t_Header.m_LeafIndexCount) * sizeof(int);
+        u64 t_LODIndexOffset = t_PartOffset + u64(t_Header.m_PartCount) * sizeof(MeshPart);
+        u64 t_LODOffset     = t_LODIndexOffset + u64(t_Header.m_LODIndexCount) * sizeof(int);
+        u64 t_LODPartOffset = t_LODOffset + u64(t_Header.m_LODCount) * sizeof(MeshBinaryLOD);
+        u64 t_RemapOffset   = t_LODPartOffset + u64(t_Header.m_LODPartCount) * sizeof(MeshPart);
+        u64 t_End           = t_RemapOffset + u64(t_Header.m_LODCount) * t_Header.m_VertexCount * sizeof(u32);
+        if (t_End > t_File.GetSize())
+            return false;
+
+        const Vertex * t_Vertices = reinterpret_cast<const Vertex *>(t_Data + t_VertexOffset);
+        const int * t_Indices = reinterpret_cast<const int *>(t_Data + t_IndexOffset);
+        const HierachicalAABBNodeRecord * t_Nodes = reinterpret_cast<const HierachicalAABBNodeRecord *>(t_Data + t_NodeOffset);
+        const int * t_LeafIndices = reinterpret_cast<const int *>(t_Data + t_LeafOffset);
+        const MeshPart * t_Parts = reinterpret_cast<const MeshPart *>(t_Data + t_PartOffset);
+        const int * t_LODIndices = reinterpret_cast<const int *>(t_Data + t_LODIndexOffset);
+        const MeshBinaryLOD * t_LODs = reinterpret_cast<const MeshBinaryLOD *>(t_Data + t_LODOffset);
+        const MeshPart * t_LODParts = reinterpret_cast<const MeshPart *>(t_Data + t_LODPartOffset);
+        const u32 * t_Remaps = reinterpret_cast<const u32 *>(t_Data + t_RemapOffset);
+
+        // every leaf range has to lie inside the leaf index section
+        for (u32 i = 0; i < t_Header.m_NodeCount; ++i)
+        {
+            if (u64(t_Nodes[i].indexStart) + t_Nodes[i].indexCount > t_Header.m_LeafIndexCount)
+                return false;
+        }
+        for (u32 i = 0; i < t_Header.m_PartCount; ++i)
+        {
+            if (u64(t_Parts[i].indexStart) + t_Parts[i].indexCount > t_Header.m_IndexCount)
+                return false;
+        }
+        for (u32 i = 0; i < t_Header.m_IndexCount; ++i)
+        {
+            if (u32(t_Indices[i]) >= t_Header.m_VertexCount)
+                return false;
+        }
+
+        for (u32 i = 0; i < t_Header.m_LODCount; ++i)
+        {
+            if (u64(t_LODs[i].m_PartStart) + t_LODs[i].m_PartCount > t_Header.m_LODPartCount)
+                return false;
+        }
+        for (u32 i = 0; i < t_Header.m_LODPartCount; ++i)
+        {
+            if (u64(t_LODParts[i].indexStart) + t_LODParts[i].indexCount > t_Header.m_LODIndexCount)
+                return false;
+        }
+        for (u32 i = 0; i < t_Header.m_LODIndexCount; ++i)
+        {
+            if (u32(t_LODIndices[i]) >= t_Header.m_VertexCount)
+                return false;
+        }
+        for (u64 i = 0; i < u64(t_Header.m_LODCount) * t_Header.m_VertexCount; ++i)
+        {
+            if (t_Remaps[i] >= t_Header.m_VertexCount)
+                return false;
+        }
+
+        t_Mesh.vertexBuffer.assign(t_Vertices, t_Vertices + t_Header.m_VertexCount);
+        t_Mesh.indexBuffer.assign(t_Indices, t_Indices + t_Header.m_IndexCount);
+        t_Mesh.parts.assign(t_Parts, t_Parts + t_Header.m_PartCount);
+
+        t_Mesh.lodIndexBuffer.assign(t_LODIndices, t_LODIndices + t_Header.m_LODIndexCount);
+        t_Mesh.lods.resize(t_Header.m_LODCount);
+        for (u32 i = 0; i < t_Header.m_LODCount; ++i)
+        {
+            MeshLOD & t_LOD = t_Mesh.lods[i];
+            const MeshPart * t_FirstPart = t_LODParts + t_LODs[i].m_PartStart;
+            const u32 * t_Remap = t_Remaps + u64(i) * t_Header.m_VertexCount;
+            t_LOD.error = t_LODs[i].m_Error;
+            t_LOD.parts.assign(t_FirstPart, t_FirstPart + t_LODs[i].m_PartCount);
+            t_LOD.vertexRemap.assign(t_Remap, t_Remap + t_Header.m_VertexCount);
+        }
+        t_Mesh.numVertices  = t_Header.m_VertexCount;
+        t_Mesh.numIndices   = t_Header.m_IndexCount;
+        t_Mesh.numTris      = t_Header.m_IndexCount / 3;
+
+        t_Tree.ImportRecords(t_Nodes, t_Header.m_NodeCount, t_LeafIndices, t_Header.m_TreeMaxDepth);
+
+        t_AABB.m_Center = vec3(t_Header.m_AABBCenter[0], t_Header.m_AABBCenter[1], t_Header.m_AABBCenter[2]);
+        t_AABB.m_Radius = vec3(t_Header.m_AABBRadius[0], t_Header.m_AABBRadius[1], t_Header.m_AABBRadius[2]);
+        t_BS.m_Center   = vec3(t_Header.m_BSCenter[0], t_Header.m_BSCenter[1], t_Header.m_BSCenter[2]);
+        t_BS.m_Radius   = t_Header.m_BSRadius;
+
+        return true;
+    }
+}
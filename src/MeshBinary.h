@@ -0,0 +1,86 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshBinary.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MESHBINARY_H_
+#define _MESHBINARY_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "BS.h"
+#include "AABB.h"
+#include "Mesh.hpp"
+#include "HierachicalAABB.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+// extension appended to a model's file name for its binary cache
+#define MESH_BINARY_EXT     ".msb"
+#define MESH_BINARY_VERSION 4
+
+namespace Proto
+{
+    // .msb layout, every section starts 4-byte aligned:
+    //   MeshBinaryHeader
+    //   Vertex                     [vertexCount]  interleaved, as uploaded
+    //   int                        [indexCount]
+    //   HierachicalAABBNodeRecord  [nodeCount]
+    //   int                        [leafIndexCount]
+    //   MeshPart                   [partCount]    draw ranges, may be empty
+    //   int                        [lodIndexCount]
+    //   MeshBinaryLOD              [lodCount]
+    //   MeshPart                   [lodPartCount]
+    //   u32                        [lodCount * vertexCount] vertex remaps
+    struct MeshBinaryLOD
+    {
+        f32     m_Error;
+        u32     m_PartStart;
+        u32     m_PartCount;
+    };
+
+    struct MeshBinaryHeader
+    {
+        char    m_Magic[4];
+        u32     m_Version;
+        u32     m_VertexSize;
+        u32     m_NodeSize;
+
+        // size and modification time of the file the cache was made from,
+        // a cache whose source has changed since is not used
+        u64     m_SourceSize;
+        u64     m_SourceTime;
+
+        u32     m_VertexCount;
+        u32     m_IndexCount;
+        u32     m_NodeCount;
+        u32     m_LeafIndexCount;
+        u32     m_TreeMaxDepth;
+        u32     m_PartCount;
+        u32     m_LODCount;
+        u32     m_LODIndexCount;
+        u32     m_LODPartCount;
+
+        f32     m_AABBCenter[3];
+        f32     m_AABBRadius[3];
+        f32     m_BSCenter[3];
+        f32     m_BSRadius;
+    };
+
+    bool WriteMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                         const Mesh & t_Mesh, 
+                         const HierachicalAABB & t_Tree,
+                         const AABB & t_AABB, const BS & t_BS);
+
+    bool ReadMeshBinary(const str & t_FileName, const str & t_SourceFileName,
+                        Mesh & t_Mesh, 
+                        HierachicalAABB & t_Tree,
+                        AABB & t_AABB, BS & t_BS);
+}
+
+#endif
@@ -0,0 +1,364 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshOptimizer.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include "MeshOptimizer.h"
+
+namespace Proto
+{
+    namespace
+    {
+        // Forsyth, "Linear-Speed Vertex Cache Optimisation"
+        const s32 CACHE_SIZE            = 32;
+        const f32 CACHE_DECAY_POWER     = 1.5f;
+        const f32 LAST_TRI_SCORE        = 0.75f;
+        const f32 VALENCE_BOOST_SCALE   = 2.0f;
+        const f32 VALENCE_BOOST_POWER   = 0.5f;
+
+        f32 VertexScore(s32 t_CachePosition, u32 t_Valence)
+        {
+            // no triangles left to draw, the vertex no longer matters
+            if (t_Valence == 0)
+                return -1.f;
+
+            f32 score = 0.f;
+            if (t_CachePosition >= 0)
+            {
+                // the last triangle's vertices get a fixed score so that 
+                // strips are not favoured over fans
+                if (t_CachePosition < 3)
+                    score = LAST_TRI_SCORE;
+                else
+                    score = powf(1.f - (t_CachePosition - 3) / f32(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+            }
+
+            // favour vertices with few triangles left, to finish them off
+            score += VALENCE_BOOST_SCALE * powf(f32(t_Valence), -VALENCE_BOOST_POWER);
+            return score;
+        }
+
+        // spreads the lower 10 bits of t_Value to every third bit
+        u32 ExpandBits(u32 t_Value)
+        {
+            t_Value = (t_Value * 0x00010001u) & 0xFF0000FFu;
+            t_Value = (t_Value * 0x00000101u) & 0x0F00F00Fu;
+            t_Value = (t_Value * 0x00000011u) & 0xC30C30C3u;
+            t_Value = (t_Value * 0x00000005u) & 0x49249249u;
+            return t_Value;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void SortTrianglesMorton(const VertexBufferType & t_Vertices, 
+                                 IndexBufferType & t_Indices)
+
+    \brief
+        Sorts the triangles by the Morton code of their centroids within the
+        mesh bounds, so that triangles close in space are close in memory.
+    */
+    /*************************************************************************/
+    void SortTrianglesMorton(const VertexBufferType & t_Vertices, IndexBufferType & t_Indices)
+    {
+        u32 totalTris = t_Indices.size() / 3;
+        if (totalTris < 2)
+            return;
+
+        vec3 minPt(FLT_MAX), maxPt(-FLT_MAX);
+        for (u32 i = 0; i < t_Vertices.size(); ++i)
+        {
+            minPt = glm::min(minPt, t_Vertices[i].pos);
+            maxPt = glm::max(maxPt, t_Vertices[i].pos);
+        }
+
+        vec3 extent = maxPt - minPt;
+        f32 scale = std::max(extent.x, std::max(extent.y, extent.z));
+        scale = (scale > 0.f) ? 1023.f / scale : 0.f;
+
+        std::vector<std::pair<u32, u32> > keys(totalTris);
+        for (u32 i = 0; i < totalTris; ++i)
+        {
+            vec3 centroid = (t_Vertices[t_Indices[i * 3]].pos +
+                             t_Vertices[t_Indices[i * 3 + 1]].pos +
+                             t_Vertices[t_Indices[i * 3 + 2]].pos) * (1.f / 3.f);
+            vec3 cell = (centroid - minPt) * scale;
+
+            u32 code = (ExpandBits(u32(cell.x)) << 2) | (ExpandBits(u32(cell.y)) << 1) | ExpandBits(u32(cell.z));
+            keys[i] = std::make_pair(code, i);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        IndexBufferType sorted(totalTris * 3);
+        for (u32 i = 0; i < totalTris; ++i)
+        {
+            u32 tri = keys[i].second;
+            sorted[i * 3]       = t_Indices[tri * 3];
+            sorted[i * 3 + 1]   = t_Indices[tri * 3 + 1];
+            sorted[i * 3 + 2]   = t_Indices[tri * 3 + 2];
+        }
+        t_Indices.swap(sorted);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void OptimizeVertexCache(IndexBufferType & t_Indices, u32 t_VertexCount)
+
+    \brief
+        Reorders the triangles for the GPU post-transform cache.
+        Greedily emits the best scored triangle among those touching the 
+        simulated cache. When the cache has nothing left to offer, the 
+        next unemitted triangle in the current order is taken, so an 
+        earlier spatial sort is mostly kept.
+    */
+    /*************************************************************************/
+    void OptimizeVertexCache(IndexBufferType & t_Indices, u32 t_VertexCount)
+    {
+        u32 totalTris = t_Indices.size() / 3;
+        if (totalTris < 2)
+            return;
+
+        // triangles of every vertex, the first valence[v] are not emitted yet
+        std::vector<u32> valence(t_VertexCount, 0);
+        for (u32 i = 0; i < totalTris * 3; ++i)
+            ++valence[t_Indices[i]];
+
+        std::vector<u32> triStart(t_VertexCount + 1, 0);
+        for (u32 v = 0; v < t_VertexCount; ++v)
+            triStart[v + 1] = triStart[v] + valence[v];
+
+        std::vector<u32> vertexTris(totalTris * 3);
+        std::vector<u32> cursor(triStart.begin(), triStart.end() - 1);
+        for (u32 i = 0; i < totalTris * 3; ++i)
+            vertexTris[cursor[t_Indices[i]]++] = i / 3;
+
+        std::vector<s32> cachePosition(t_VertexCount, -1);
+        std::vector<f32> vertexScore(t_VertexCount);
+        for (u32 v = 0; v < t_VertexCount; ++v)
+            vertexScore[v] = VertexScore(-1, valence[v]);
+
+        std::vector<f32> triScore(totalTris);
+        std::vector<u8> emitted(totalTris, 0);
+        for (u32 t = 0; t < totalTris; ++t)
+        {
+            triScore[t] = vertexScore[t_Indices[t * 3]] + 
+                          vertexScore[t_Indices[t * 3 + 1]] + 
+                          vertexScore[t_Indices[t * 3 + 2]];
+        }
+
+        IndexBufferType output;
+        output.reserve(totalTris * 3);
+
+        std::vector<u32> cache, newCache;
+        cache.reserve(CACHE_SIZE + 3);
+        newCache.reserve(CACHE_SIZE + 3);
+
+        u32 nextSeed = 0;
+        s32 bestTri = -1;
+
+        for (u32 n = 0; n < totalTris; ++n)
+        {
+            if (bestTri == -1)
+            {
+                while (emitted[nextSeed])
+                    ++nextSeed;
+                bestTri = nextSeed;
+            }
+
+            emitted[bestTri] = 1;
+            newCache.clear();
+
+            for (int k = 0; k < 3; ++k)
+            {
+                u32 v = t_Indices[bestTri * 3 + k];
+                output.push_back(v);
+                newCache.push_back(v);
+
+                // drop the triangle from the vertex's pending list
+                u32 begin = triStart[v], end = begin + valence[v];
+                for (u32 j = begin; j < end; ++j)
+                {
+                    if (vertexTris[j] == u32(bestTri))
+                    {
+                        std::swap(vertexTris[j], vertexTris[end - 1]);
+                        break;
+                    }
+                }
+                --valence[v];
+            }
+
+            // the emitted vertices move to the front of the cache
+            for (u32 i = 0; i < cache.size(); ++i)
+            {
+                u32 v = cache[i];
+                if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+                    newCache.push_back(v);
+            }
+
+            // rescore the cache and everything touching it
+            for (u32 i = 0; i < newCache.size(); ++i)
+            {
+                u32 v = newCache[i];
+                cachePosition[v] = (i < u32(CACHE_SIZE)) ? s32(i) : -1;
+                vertexScore[v] = VertexScore(cachePosition[v], valence[v]);
+            }
+
+            bestTri = -1;
+            f32 bestScore = -1.f;
+            for (u32 i = 0; i < newCache.size(); ++i)
+            {
+                u32 v = newCache[i];
+                u32 begin = triStart[v], end = begin + valence[v];
+                for (u32 j = begin; j < end; ++j)
+                {
+                    u32 t = vertexTris[j];
+                    triScore[t] = vertexScore[t_Indices[t * 3]] + 
+                                  vertexScore[t_Indices[t * 3 + 1]] + 
+                                  vertexScore[t_Indices[t * 3 + 2]];
+                    if (triScore[t] > bestScore)
+                    {
+                        bestScore = triScore[t];
+                        bestTri = t;
+                    }
+                }
+            }
+
+            if (newCache.size() > u32(CACHE_SIZE))
+                newCache.resize(CACHE_SIZE);
+            cache.swap(newCache);
+        }
+
+        // leave any trailing partial triangle as it was
+        t_Indices.erase(t_Indices.begin(), t_Indices.begin() + totalTris * 3);
+        output.insert(output.end(), t_Indices.begin(), t_Indices.end());
+        t_Indices.swap(output);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void OptimizeVertexFetch(VertexBufferType & t_Vertices, 
+                                 IndexBufferType & t_Indices)
+
+    \brief
+        Renumbers the vertices in the order the index buffer first uses 
+        them, so that vertex reads walk forward through memory. Vertices 
+        no triangle uses are kept, after the used ones.
+    */
+    /*************************************************************************/
+    void OptimizeVertexFetch(VertexBufferType & t_Vertices, IndexBufferType & t_Indices)
+    {
+        u32 totalVertices = t_Vertices.size();
+        std::vector<s32> remap(totalVertices, -1);
+        s32 next = 0;
+
+        for (u32 i = 0; i < t_Indices.size(); ++i)
+        {
+            int& v = t_Indices[i];
+            if (remap[v] == -1)
+                remap[v] = next++;
+            v = remap[v];
+        }
+
+        for (u32 v = 0; v < totalVertices; ++v)
+        {
+            if (remap[v] == -1)
+                remap[v] = next++;
+        }
+
+        VertexBufferType reordered(totalVertices);
+        for (u32 v = 0; v < totalVertices; ++v)
+            reordered[remap[v]] = t_Vertices[v];
+        t_Vertices.swap(reordered);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void GroupPartsByMaterial(Mesh & t_Mesh)
+
+    \brief
+        Moves the triangles of parts sharing a material next to each other,
+        keeping part order otherwise, and replaces the parts with one draw
+        range per material.
+    */
+    /*************************************************************************/
+    void GroupPartsByMaterial(Mesh & t_Mesh)
+    {
+        MeshPartBufferType & parts = t_Mesh.parts;
+        if (parts.size() < 2)
+            return;
+
+        std::vector<u32> order(parts.size());
+        for (u32 i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&parts](u32 a, u32 b)
+        {
+            return parts[a].materialIndex < parts[b].materialIndex;
+        });
+
+        IndexBufferType indices;
+        indices.reserve(t_Mesh.indexBuffer.size());
+        MeshPartBufferType grouped;
+
+        for (u32 i = 0; i < order.size(); ++i)
+        {
+            const MeshPart & part = parts[order[i]];
+            if (grouped.empty() || grouped.back().materialIndex != part.materialIndex)
+            {
+                MeshPart range = { static_cast<u32>(indices.size()), 0, part.materialIndex };
+                grouped.push_back(range);
+            }
+
+            IndexBufferType::const_iterator first = t_Mesh.indexBuffer.begin() + part.indexStart;
+            indices.insert(indices.end(), first, first + part.indexCount);
+            grouped.back().indexCount += part.indexCount;
+        }
+
+        t_Mesh.indexBuffer.swap(indices);
+        parts.swap(grouped);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void OptimizeMesh(Mesh & t_Mesh)
+
+    \brief
+        Runs the load-time reordering passes on a triangle mesh and 
+        refreshes its CPU streams. Triangles are only reordered within
+        their draw range.
+    */
+    /*************************************************************************/
+    void OptimizeMesh(Mesh & t_Mesh)
+    {
+        if (t_Mesh.indexBuffer.size() < 3 || t_Mesh.vertexBuffer.empty())
+            return;
+
+        if (t_Mesh.parts.size() < 2)
+        {
+#if MESH_MORTON_ORDER
+            SortTrianglesMorton(t_Mesh.vertexBuffer, t_Mesh.indexBuffer);
+#endif
+            OptimizeVertexCache(t_Mesh.indexBuffer, t_Mesh.vertexBuffer.size());
+        }
+        else
+        {
+            IndexBufferType range;
+            for (u32 i = 0; i < t_Mesh.parts.size(); ++i)
+            {
+                const MeshPart & part = t_Mesh.parts[i];
+                IndexBufferType::iterator first = t_Mesh.indexBuffer.begin() + part.indexStart;
+                range.assign(first, first + part.indexCount);
+#if MESH_MORTON_ORDER
+                SortTrianglesMorton(t_Mesh.vertexBuffer, range);
+#endif
+                OptimizeVertexCache(range, t_Mesh.vertexBuffer.size());
+                std::copy(range.begin(), range.end(), first);
+            }
+        }
+        OptimizeVertexFetch(t_Mesh.vertexBuffer, t_Mesh.indexBuffer);
+
+        t_Mesh.UpdateCPUStreams();
+    }
+}
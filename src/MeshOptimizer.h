@@ -0,0 +1,34 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshOptimizer.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MESHOPTIMIZER_H_
+#define _MESHOPTIMIZER_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Mesh.hpp"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Load-time reordering of a triangle mesh for locality. 
+    // Only the order of triangles and vertices changes, never the shape.
+    // Anything derived from the buffers has to be built after this runs.
+
+    void    SortTrianglesMorton(const VertexBufferType & t_Vertices, IndexBufferType & t_Indices);
+    void    OptimizeVertexCache(IndexBufferType & t_Indices, u32 t_VertexCount);
+    void    OptimizeVertexFetch(VertexBufferType & t_Vertices, IndexBufferType & t_Indices);
+    void    GroupPartsByMaterial(Mesh & t_Mesh);
+
+    void    OptimizeMesh(Mesh & t_Mesh);
+}
+
+#endif
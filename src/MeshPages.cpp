@@ -0,0 +1,503 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshPages.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <cstring>
+#include <algorithm>
+
+#include "MeshPages.h"
+
+namespace Proto
+{
+    static const char s_MeshPagesMagic[4] = { 'M', 'S', 'P', '1' };
+    static const u32 s_VertexPageBit = 0x80000000u;
+    static const u32 s_TriangleFloats = 12;     // per triangle record
+    static const u32 s_VertexFloats = 6;        // position and normal
+
+    u64 MeshPage::GetBytes() const
+    {
+        return sizeof(MeshPage) + u64(m_Triangles.Size()) * s_TriangleFloats * sizeof(f32) +
+               u64(m_Positions.size() + m_Normals.size()) * sizeof(vec3);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool WriteMeshPages(const str & t_FileName, const Mesh & t_Mesh,
+                            const HierachicalAABB & t_Tree,
+                            const TriangleRecords & t_Triangles)
+
+    \brief
+        Writes the query data of a model as a .msp page file. Consecutive
+        leaves share a triangle page until it holds MESH_PAGE_TRIANGLES
+        records; a larger leaf gets a page of its own. Pages only ever end
+        on a leaf boundary, so every leaf is read from a single page.
+
+    \return
+        false if the file could not be written.
+    */
+    /*************************************************************************/
+    bool WriteMeshPages(const str & t_FileName, const Mesh & t_Mesh,
+                        const HierachicalAABB & t_Tree, const TriangleRecords & t_Triangles)
+    {
+        MeshPagesHeader t_Header;
+        memcpy(t_Header.m_Magic, s_MeshPagesMagic, sizeof(t_Header.m_Magic));
+        t_Header.m_Version          = MESH_PAGES_VERSION;
+        t_Header.m_VertexCount      = t_Mesh.positionBuffer.size();
+        t_Header.m_NodeCount        = t_Tree.nodes.size();
+        t_Header.m_VerticesPerPage  = MESH_PAGE_VERTICES;
+        t_Header.m_VertexPageCount  = (t_Header.m_VertexCount + MESH_PAGE_VERTICES - 1) / MESH_PAGE_VERTICES;
+
+        if (t_Mesh.normalBuffer.size() != t_Header.m_VertexCount)
+            return false;
+
+        // the records are in node order, so the leaves of a page are contiguous
+        std::vector<s32> t_LeafPages(t_Header.m_NodeCount, -1);
+        std::vector<s32> t_VertexLeaves(t_Header.m_VertexCount, -1);
+        std::vector<MeshPagesEntry> t_Entries;
+        MeshPagesEntry t_Page = { 0, 0, 0 };
+
+        for (u32 i = 0; i < t_Header.m_NodeCount; ++i)
+        {
+            const HierachicalAABBNode& node = t_Tree.nodes[i];
+            if (node.index == -1 || (node.m_LeftChild != -1 && node.m_RightChild != -1))
+                continue;
+
+            for (u32 j = 0; j < node.indices.size(); ++j)
+            {
+                if (t_VertexLeaves[node.indices[j]] == -1)
+                    t_VertexLeaves[node.indices[j]] = i;
+            }
+
+            if (node.triangleCount == 0)
+                continue;
+            if (t_Page.m_Count && (t_Page.m_Count + node.triangleCount > MESH_PAGE_TRIANGLES ||
+                                   t_Page.m_First + t_Page.m_Count != node.triangleStart))
+            {
+                t_Entries.push_back(t_Page);
+                t_Page.m_Count = 0;
+            }
+            if (t_Page.m_Count == 0)
+                t_Page.m_First = node.triangleStart;
+            t_LeafPages[i] = t_Entries.size();
+            t_Page.m_Count += node.triangleCount;
+        }
+        if (t_Page.m_Count)
+            t_Entries.push_back(t_Page);
+        t_Header.m_TrianglePageCount = t_Entries.size();
+
+        for (u32 i = 0; i < t_Header.m_VertexPageCount; ++i)
+        {
+            t_Page.m_First = i * MESH_PAGE_VERTICES;
+            t_Page.m_Count = std::min<u32>(MESH_PAGE_VERTICES, t_Header.m_VertexCount - t_Page.m_First);
+            t_Entries.push_back(t_Page);
+        }
+
+        u64 t_Offset = sizeof(MeshPagesHeader) + u64(t_Header.m_NodeCount) * sizeof(s32) +
+                       u64(t_Header.m_VertexCount) * sizeof(s32) + u64(t_Entries.size()) * sizeof(MeshPagesEntry);
+        for (u32 i = 0; i < t_Entries.size(); ++i)
+        {
+            t_Entries[i].m_Offset = t_Offset;
+            t_Offset += u64(t_Entries[i].m_Count) * sizeof(f32) *
+                        (i < t_Header.m_TrianglePageCount ? s_TriangleFloats : s_VertexFloats);
+        }
+
+        std::ofstream t_File(t_FileName.c_str(), std::ios::binary);
+        if (!t_File)
+            return false;
+
+        t_File.write(reinterpret_cast<const char *>(&t_Header), sizeof(t_Header));
+        if (!t_LeafPages.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_LeafPages[0]), t_LeafPages.size() * sizeof(s32));
+        if (!t_VertexLeaves.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_VertexLeaves[0]), t_VertexLeaves.size() * sizeof(s32));
+        if (!t_Entries.empty())
+            t_File.write(reinterpret_cast<const char *>(&t_Entries[0]), t_Entries.size() * sizeof(MeshPagesEntry));
+
+        const std::vector<f32> * t_Arrays[s_TriangleFloats] =
+        {
+            &t_Triangles.m_V0[0],       &t_Triangles.m_V0[1],       &t_Triangles.m_V0[2],
+            &t_Triangles.m_Edge1[0],    &t_Triangles.m_Edge1[1],    &t_Triangles.m_Edge1[2],
+            &t_Triangles.m_Edge2[0],    &t_Triangles.m_Edge2[1],    &t_Triangles.m_Edge2[2],
+            &t_Triangles.m_Normal[0],   &t_Triangles.m_Normal[1],   &t_Triangles.m_Normal[2]
+        };
+        for (u32 i = 0; i < t_Header.m_TrianglePageCount; ++i)
+        {
+            for (u32 j = 0; j < s_TriangleFloats; ++j)
+                t_File.write(reinterpret_cast<const char *>(&(*t_Arrays[j])[t_Entries[i].m_First]), t_Entries[i].m_Count * sizeof(f32));
+        }
+        for (u32 i = t_Header.m_TrianglePageCount; i < t_Entries.size(); ++i)
+        {
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.positionBuffer[t_Entries[i].m_First]), t_Entries[i].m_Count * sizeof(vec3));
+            t_File.write(reinterpret_cast<const char *>(&t_Mesh.normalBuffer[t_Entries[i].m_First]), t_Entries[i].m_Count * sizeof(vec3));
+        }
+
+        return t_File.good();
+    }
+
+    MeshPageFile::MeshPageFile()
+    {
+        memset(&m_Header, 0, sizeof(m_Header));
+    }
+
+    MeshPageFile::~MeshPageFile()
+    {
+        Close();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool MeshPageFile::Open(const str & t_FileName)
+
+    \brief
+        Opens a .msp file and reads its tables. The pages themselves are
+        left on disk.
+
+    \return
+        false if the file is missing, of another version or inconsistent.
+    */
+    /*************************************************************************/
+    bool MeshPageFile::Open(const str & t_FileName)
+    {
+        Close();
+
+        m_File.open(t_FileName.c_str(), std::ios::binary);
+        if (!m_File)
+            return false;
+
+        m_File.seekg(0, std::ios::end);
+        u64 t_Size = u64(m_File.tellg());
+
+        if (t_Size < sizeof(m_Header) || !ReadAt(0, &m_Header, sizeof(m_Header)) ||
+            memcmp(m_Header.m_Magic, s_MeshPagesMagic, sizeof(m_Header.m_Magic)) != 0 ||
+            m_Header.m_Version != MESH_PAGES_VERSION || m_Header.m_VerticesPerPage == 0 ||
+            m_Header.m_VertexPageCount != (m_Header.m_VertexCount + m_Header.m_VerticesPerPage - 1) / m_Header.m_VerticesPerPage)
+        {
+            Close();
+            return false;
+        }
+
+        u64 t_LeafOffset    = sizeof(m_Header);
+        u64 t_VertexOffset  = t_LeafOffset + u64(m_Header.m_NodeCount) * sizeof(s32);
+        u64 t_EntryOffset   = t_VertexOffset + u64(m_Header.m_VertexCount) * sizeof(s32);
+        u64 t_EntryCount    = u64(m_Header.m_TrianglePageCount) + m_Header.m_VertexPageCount;
+        u64 t_End           = t_EntryOffset + t_EntryCount * sizeof(MeshPagesEntry);
+        if (t_End > t_Size)
+        {
+            Close();
+            return false;
+        }
+
+        m_LeafPages.resize(m_Header.m_NodeCount);
+        m_VertexLeaves.resize(m_Header.m_VertexCount);
+        m_Entries.resize(size_t(t_EntryCount));
+        bool t_Read = (m_LeafPages.empty() || ReadAt(t_LeafOffset, &m_LeafPages[0], m_LeafPages.size() * sizeof(s32))) &&
+                      (m_VertexLeaves.empty() || ReadAt(t_VertexOffset, &m_VertexLeaves[0], m_VertexLeaves.size() * sizeof(s32))) &&
+                      (m_Entries.empty() || ReadAt(t_EntryOffset, &m_Entries[0], m_Entries.size() * sizeof(MeshPagesEntry)));
+
+        // every index has to stay inside the tables and every page inside the file
+        for (u32 i = 0; t_Read && i < m_LeafPages.size(); ++i)
+            t_Read = m_LeafPages[i] < s32(m_Header.m_TrianglePageCount);
+        for (u32 i = 0; t_Read && i < m_VertexLeaves.size(); ++i)
+            t_Read = m_VertexLeaves[i] < s32(m_Header.m_NodeCount);
+        for (u32 i = 0; t_Read && i < m_Entries.size(); ++i)
+        {
+            u64 t_Floats = (i < m_Header.m_TrianglePageCount) ? s_TriangleFloats : s_VertexFloats;
+            t_Read = m_Entries[i].m_Offset + u64(m_Entries[i].m_Count) * t_Floats * sizeof(f32) <= t_Size;
+            if (t_Read && i >= m_Header.m_TrianglePageCount)
+                t_Read = u64(m_Entries[i].m_First) + m_Entries[i].m_Count <= m_Header.m_VertexCount;
+        }
+
+        if (!t_Read)
+            Close();
+        return t_Read;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void MeshPageFile::Close()
+
+    \brief
+        Closes the file and drops its pages from the cache.
+    */
+    /*************************************************************************/
+    void MeshPageFile::Close()
+    {
+        if (m_File.is_open())
+            MeshPageCache::GetInstance().Release(*this);
+
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        if (m_File.is_open())
+            m_File.close();
+        m_File.clear();
+        memset(&m_Header, 0, sizeof(m_Header));
+        m_LeafPages.clear();
+        m_VertexLeaves.clear();
+        m_Entries.clear();
+    }
+
+    bool MeshPageFile::IsOpen() const
+    {
+        return m_File.is_open();
+    }
+
+    u32 MeshPageFile::GetVertexCount() const
+    {
+        return m_Header.m_VertexCount;
+    }
+
+    u32 MeshPageFile::GetNodeCount() const
+    {
+        return m_Header.m_NodeCount;
+    }
+
+    s32 MeshPageFile::GetVertexLeaf(u32 t_Vertex) const
+    {
+        return m_VertexLeaves[t_Vertex];
+    }
+
+    u32 MeshPageFile::GetVertexPage(u32 t_Vertex) const
+    {
+        return t_Vertex / m_Header.m_VerticesPerPage;
+    }
+
+    s32 MeshPageFile::GetLeafPage(s32 t_Node) const
+    {
+        return (t_Node >= 0 && u32(t_Node) < m_LeafPages.size()) ? m_LeafPages[t_Node] : -1;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool MeshPageFile::HoldsWholeLeaves(const HierachicalAABB & t_Tree) const
+
+    \brief
+        Checks the page table against the leaf ranges of the model's tree.
+        Queries read a leaf from the one page GetLeafPage names, so a file 
+        whose pages split a leaf is not usable.
+    */
+    /*************************************************************************/
+    bool MeshPageFile::HoldsWholeLeaves(const HierachicalAABB & t_Tree) const
+    {
+        if (t_Tree.nodes.size() != m_LeafPages.size())
+            return false;
+
+        for (u32 i = 0; i < t_Tree.nodes.size(); ++i)
+        {
+            const HierachicalAABBNode& node = t_Tree.nodes[i];
+            if (node.index == -1 || (node.m_LeftChild != -1 && node.m_RightChild != -1) || node.triangleCount == 0)
+                continue;
+
+            s32 t_Page = m_LeafPages[i];
+            if (t_Page == -1)
+                return false;
+            const MeshPagesEntry& t_Entry = m_Entries[t_Page];
+            if (node.triangleStart < t_Entry.m_First ||
+                u64(node.triangleStart) + node.triangleCount > u64(t_Entry.m_First) + t_Entry.m_Count)
+                return false;
+        }
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn MeshPagePtr MeshPageFile::ReadTrianglePage(u32 t_Page)
+
+    \brief
+        Reads a triangle page from disk. Its records are numbered from 0,
+        record i of the page is record m_First + i of the model.
+
+    \return
+        The page, or null if it could not be read.
+    */
+    /*************************************************************************/
+    MeshPagePtr MeshPageFile::ReadTrianglePage(u32 t_Page)
+    {
+        if (t_Page >= m_Header.m_TrianglePageCount)
+            return MeshPagePtr();
+
+        const MeshPagesEntry& t_Entry = m_Entries[t_Page];
+        std::vector<f32> t_Data(size_t(t_Entry.m_Count) * s_TriangleFloats);
+        if (!t_Data.empty() && !ReadAt(t_Entry.m_Offset, &t_Data[0], t_Data.size() * sizeof(f32)))
+            return MeshPagePtr();
+
+        std::shared_ptr<MeshPage> t_Result = std::make_shared<MeshPage>();
+        t_Result->m_First = t_Entry.m_First;
+
+        std::vector<f32> * t_Arrays[s_TriangleFloats] =
+        {
+            &t_Result->m_Triangles.m_V0[0],     &t_Result->m_Triangles.m_V0[1],     &t_Result->m_Triangles.m_V0[2],
+            &t_Result->m_Triangles.m_Edge1[0],  &t_Result->m_Triangles.m_Edge1[1],  &t_Result->m_Triangles.m_Edge1[2],
+            &t_Result->m_Triangles.m_Edge2[0],  &t_Result->m_Triangles.m_Edge2[1],  &t_Result->m_Triangles.m_Edge2[2],
+            &t_Result->m_Triangles.m_Normal[0], &t_Result->m_Triangles.m_Normal[1], &t_Result->m_Triangles.m_Normal[2]
+        };
+        for (u32 i = 0; i < s_TriangleFloats; ++i)
+        {
+            const f32 * t_Begin = t_Data.empty() ? nullptr : &t_Data[0] + size_t(i) * t_Entry.m_Count;
+            t_Arrays[i]->assign(t_Begin, t_Begin + t_Entry.m_Count);
+        }
+        return t_Result;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn MeshPagePtr MeshPageFile::ReadVertexPage(u32 t_Page)
+
+    \brief
+        Reads the positions and normals of a vertex page from disk.
+
+    \return
+        The page, or null if it could not be read.
+    */
+    /*************************************************************************/
+    MeshPagePtr MeshPageFile::ReadVertexPage(u32 t_Page)
+    {
+        if (t_Page >= m_Header.m_VertexPageCount)
+            return MeshPagePtr();
+
+        const MeshPagesEntry& t_Entry = m_Entries[m_Header.m_TrianglePageCount + t_Page];
+        std::shared_ptr<MeshPage> t_Result = std::make_shared<MeshPage>();
+        t_Result->m_First = t_Entry.m_First;
+        t_Result->m_Positions.resize(t_Entry.m_Count);
+        t_Result->m_Normals.resize(t_Entry.m_Count);
+
+        u64 t_Bytes = u64(t_Entry.m_Count) * sizeof(vec3);
+        if (t_Entry.m_Count &&
+            (!ReadAt(t_Entry.m_Offset, &t_Result->m_Positions[0], t_Bytes) ||
+             !ReadAt(t_Entry.m_Offset + t_Bytes, &t_Result->m_Normals[0], t_Bytes)))
+            return MeshPagePtr();
+
+        return t_Result;
+    }
+
+    bool MeshPageFile::ReadAt(u64 t_Offset, void * t_Data, u64 t_Bytes)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        m_File.clear();
+        m_File.seekg(std::streamoff(t_Offset), std::ios::beg);
+        m_File.read(reinterpret_cast<char *>(t_Data), std::streamsize(t_Bytes));
+        return m_File.good();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn MeshPageCache & MeshPageCache::GetInstance()
+
+    \brief
+        Returns the page cache shared by every paged model.
+    */
+    /*************************************************************************/
+    MeshPageCache & MeshPageCache::GetInstance()
+    {
+        static MeshPageCache s_Instance;
+        return s_Instance;
+    }
+
+    MeshPageCache::MeshPageCache()
+        : m_Budget(u64(256) << 20)
+        , m_Resident(0)
+    {
+    }
+
+    MeshPagePtr MeshPageCache::GetTrianglePage(MeshPageFile & t_File, u32 t_Page)
+    {
+        return GetPage(t_File, t_Page);
+    }
+
+    MeshPagePtr MeshPageCache::GetVertexPage(MeshPageFile & t_File, u32 t_Page)
+    {
+        return GetPage(t_File, t_Page | s_VertexPageBit);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn MeshPagePtr MeshPageCache::GetPage(MeshPageFile & t_File, u32 t_Key)
+
+    \brief
+        Returns a page, reading it on a miss. The read happens outside the
+        cache lock so that hits from other threads are not held up by it;
+        if two threads miss the same page, the first one inserted wins.
+    */
+    /*************************************************************************/
+    MeshPagePtr MeshPageCache::GetPage(MeshPageFile & t_File, u32 t_Key)
+    {
+        PAGE_KEY t_PageKey(&t_File, t_Key);
+        {
+            std::lock_guard<std::mutex> t_Lock(m_Mutex);
+            PAGE_CONT::iterator t_Iter = m_Lookup.find(t_PageKey);
+            if (t_Iter != m_Lookup.end())
+            {
+                m_Pages.splice(m_Pages.begin(), m_Pages, t_Iter->second);
+                return t_Iter->second->second;
+            }
+        }
+
+        u32 t_Page = t_Key & ~s_VertexPageBit;
+        MeshPagePtr t_Result = (t_Key & s_VertexPageBit) ? t_File.ReadVertexPage(t_Page) : t_File.ReadTrianglePage(t_Page);
+        if (!t_Result)
+            return t_Result;
+
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        PAGE_CONT::iterator t_Iter = m_Lookup.find(t_PageKey);
+        if (t_Iter != m_Lookup.end())
+            return t_Iter->second->second;
+
+        m_Pages.push_front(PAGE_ENTRY(t_PageKey, t_Result));
+        m_Lookup[t_PageKey] = m_Pages.begin();
+        m_Resident += t_Result->GetBytes();
+        Evict();
+        return t_Result;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void MeshPageCache::Evict()
+
+    \brief
+        Drops least recently used pages until the budget is met, always
+        keeping the most recent one. Called with the lock held.
+    */
+    /*************************************************************************/
+    void MeshPageCache::Evict()
+    {
+        while (m_Resident > m_Budget && m_Pages.size() > 1)
+        {
+            m_Resident -= m_Pages.back().second->GetBytes();
+            m_Lookup.erase(m_Pages.back().first);
+            m_Pages.pop_back();
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void MeshPageCache::Release(const MeshPageFile & t_File)
+
+    \brief
+        Drops every cached page of t_File.
+    */
+    /*************************************************************************/
+    void MeshPageCache::Release(const MeshPageFile & t_File)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        PAGE_CONT::iterator t_Iter = m_Lookup.lower_bound(PAGE_KEY(&t_File, 0));
+        while (t_Iter != m_Lookup.end() && t_Iter->first.first == &t_File)
+        {
+            m_Resident -= t_Iter->second->second->GetBytes();
+            m_Pages.erase(t_Iter->second);
+            t_Iter = m_Lookup.erase(t_Iter);
+        }
+    }
+
+    void MeshPageCache::SetBudget(u64 t_Bytes)
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        m_Budget = t_Bytes;
+        Evict();
+    }
+
+    u64 MeshPageCache::GetResidentBytes()
+    {
+        std::lock_guard<std::mutex> t_Lock(m_Mutex);
+        return m_Resident;
+    }
+}
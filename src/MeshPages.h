@@ -0,0 +1,157 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshPages.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MESHPAGES_H_
+#define _MESHPAGES_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <map>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <fstream>
+#include "Mesh.hpp"
+#include "HierachicalAABB.h"
+#include "TriangleRecords.h"
+
+#define MESH_PAGES_EXT ".msp"
+#define MESH_PAGES_VERSION 1
+#define MESH_PAGE_TRIANGLES 4096      // target triangle records per page
+#define MESH_PAGE_VERTICES 8192       // vertices per page
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Layout of a .msp page file, the out-of-core query data of a model.
+    // Triangle pages hold whole leaves of the AABB tree in leaf order and
+    // vertex pages hold runs of the (Morton ordered) vertices, so both are
+    // spatially coherent. Only the tables stay in memory.
+    //   MeshPagesHeader
+    //   s32                [nodeCount]     triangle page of each leaf, -1 for none
+    //   s32                [vertexCount]   first leaf holding each vertex
+    //   MeshPagesEntry     [trianglePageCount + vertexPageCount]
+    //   page data          12 f32 arrays per triangle page (V0, Edge1,
+    //                      Edge2, Normal), position then normal arrays
+    //                      per vertex page
+    struct MeshPagesHeader
+    {
+        char    m_Magic[4];
+        u32     m_Version;
+        u32     m_VertexCount;
+        u32     m_NodeCount;
+        u32     m_TrianglePageCount;
+        u32     m_VertexPageCount;
+        u32     m_VerticesPerPage;
+    };
+
+    struct MeshPagesEntry
+    {
+        u64     m_Offset;
+        u32     m_First;    // first triangle record or vertex in the page
+        u32     m_Count;
+    };
+
+    // A page as held in memory. Only the members of its kind are filled.
+    struct MeshPage
+    {
+        u32                 m_First;
+        TriangleRecords     m_Triangles;
+        PositionBufferType  m_Positions;
+        PositionBufferType  m_Normals;
+
+        u64                 GetBytes() const;
+    };
+
+    typedef std::shared_ptr<const MeshPage> MeshPagePtr;
+
+    bool WriteMeshPages(const str & t_FileName, const Mesh & t_Mesh,
+                        const HierachicalAABB & t_Tree, const TriangleRecords & t_Triangles);
+
+    // An open .msp file. Pages are only read through MeshPageCache.
+    class MeshPageFile
+    {
+        public:
+
+            MeshPageFile();
+            ~MeshPageFile();
+
+            bool            Open(const str & t_FileName);
+            void            Close();
+            bool            IsOpen() const;
+
+            u32             GetVertexCount() const;
+            u32             GetNodeCount() const;
+            s32             GetVertexLeaf(u32 t_Vertex) const;
+            u32             GetVertexPage(u32 t_Vertex) const;
+            s32             GetLeafPage(s32 t_Node) const;
+
+            // true if the triangles of every leaf lie wholly in its page
+            bool            HoldsWholeLeaves(const HierachicalAABB & t_Tree) const;
+
+            MeshPagePtr     ReadTrianglePage(u32 t_Page);
+            MeshPagePtr     ReadVertexPage(u32 t_Page);
+
+        private:
+
+            MeshPageFile(const MeshPageFile &);
+            MeshPageFile & operator = (const MeshPageFile &);
+
+            bool            ReadAt(u64 t_Offset, void * t_Data, u64 t_Bytes);
+
+            std::ifstream               m_File;
+            std::mutex                  m_Mutex;        // guards m_File
+            MeshPagesHeader             m_Header;
+            std::vector<s32>            m_LeafPages;
+            std::vector<s32>            m_VertexLeaves;
+            std::vector<MeshPagesEntry> m_Entries;
+    };
+
+    // LRU cache of the pages of every open page file, bounded by a byte
+    // budget. Pages are handed out as shared pointers, so a page evicted
+    // while a query still uses it is only freed once the query is done.
+    class MeshPageCache
+    {
+        public:
+
+            static MeshPageCache &  GetInstance();
+
+            MeshPagePtr     GetTrianglePage(MeshPageFile & t_File, u32 t_Page);
+            MeshPagePtr     GetVertexPage(MeshPageFile & t_File, u32 t_Page);
+            void            Release(const MeshPageFile & t_File);
+
+            void            SetBudget(u64 t_Bytes);
+            u64             GetResidentBytes();
+
+        private:
+
+            // (file, page index with the top bit set for vertex pages)
+            typedef std::pair<const MeshPageFile *, u32>    PAGE_KEY;
+            typedef std::pair<PAGE_KEY, MeshPagePtr>        PAGE_ENTRY;
+            typedef std::list<PAGE_ENTRY>                   PAGE_LIST;
+            typedef std::map<PAGE_KEY, PAGE_LIST::iterator> PAGE_CONT;
+
+            MeshPageCache();
+            MeshPageCache(const MeshPageCache &);
+            MeshPageCache & operator = (const MeshPageCache &);
+
+            MeshPagePtr     GetPage(MeshPageFile & t_File, u32 t_Key);
+            void            Evict();
+
+            std::mutex      m_Mutex;
+            PAGE_LIST       m_Pages;        // most recently used first
+            PAGE_CONT       m_Lookup;
+            u64             m_Budget;
+            u64             m_Resident;
+    };
+}
+
+#endif
@@ -0,0 +1,866 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshReaders.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <omp.h>
+
+#include "MeshReaders.h"
+#include "MappedFile.h"
+#include "TangentSpace.h"
+
+namespace Proto
+{
+    // ==========================
+    // shared helpers
+    // ==========================
+
+    static const f64 s_Pow10[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    static inline bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static inline const char * SkipBlanks(const char * p, const char * end)
+    {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        return p;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn static const char * ParseFloat(const char * p, const char * end, f32 & t_Value)
+
+    \brief
+        Decimal to float without locale lookups or strtod. Up to 19
+        significant digits are kept, which is well past float precision.
+
+    \return
+        The position after the number, or p itself if there was none.
+    */
+    /*************************************************************************/
+    static const char * ParseFloat(const char * p, const char * end, f32 & t_Value)
+    {
+        p = SkipBlanks(p, end);
+        const char * start = p;
+
+        bool negative = false;
+        if (p != end && (*p == '-' || *p == '+'))
+            negative = (*p++ == '-');
+
+        u64 mantissa = 0;
+        s32 exponent = 0;
+        s32 digits = 0;
+        bool any = false;
+
+        for (; p != end && IsDigit(*p); ++p, any = true)
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += (mantissa != 0);
+            }
+            else
+                ++exponent;
+        }
+        if (p != end && *p == '.')
+        {
+            for (++p; p != end && IsDigit(*p); ++p, any = true)
+            {
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    digits += (mantissa != 0);
+                    --exponent;
+                }
+            }
+        }
+        if (!any)
+            return start;
+
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            const char * e = p + 1;
+            bool negativeExp = false;
+            if (e != end && (*e == '-' || *e == '+'))
+                negativeExp = (*e++ == '-');
+            if (e != end && IsDigit(*e))
+            {
+                s32 exp = 0;
+                for (; e != end && IsDigit(*e); ++e)
+                    exp = (exp < 10000) ? exp * 10 + (*e - '0') : exp;
+                exponent += negativeExp ? -exp : exp;
+                p = e;
+            }
+        }
+
+        f64 value = static_cast<f64>(mantissa);
+        if (exponent < 0)
+            value = (exponent >= -22) ? value / s_Pow10[-exponent] : value * std::pow(10.0, exponent);
+        else if (exponent > 0)
+            value = (exponent <= 22) ? value * s_Pow10[exponent] : value * std::pow(10.0, exponent);
+
+        t_Value = static_cast<f32>(negative ? -value : value);
+        return p;
+    }
+
+    static const char * ParseInt(const char * p, const char * end, s32 & t_Value)
+    {
+        const char * start = p;
+        bool negative = false;
+        if (p != end && (*p == '-' || *p == '+'))
+            negative = (*p++ == '-');
+        if (p == end || !IsDigit(*p))
+            return start;
+
+        s32 value = 0;
+        for (; p != end && IsDigit(*p); ++p)
+            value = value * 10 + (*p - '0');
+        t_Value = negative ? -value : value;
+        return p;
+    }
+
+    // the readers parse into a local mesh and only hand it over here, so a
+    // file they decline leaves the caller's mesh as it was for Assimp
+    static void FinishMesh(Mesh & t_Mesh, Mesh & t_Out, bool t_HasNormals, bool t_HasUVs)
+    {
+        t_Mesh.numVertices  = t_Mesh.vertexBuffer.size();
+        t_Mesh.numIndices   = t_Mesh.indexBuffer.size();
+        t_Mesh.numTris      = t_Mesh.numIndices / 3;
+
+        // files without normals get smooth ones over the joined vertices
+        ComputeTangentSpace(t_Mesh, !t_HasNormals, t_HasUVs);
+
+        t_Out.vertexBuffer.swap(t_Mesh.vertexBuffer);
+        t_Out.indexBuffer.swap(t_Mesh.indexBuffer);
+        t_Out.parts.clear();
+        t_Out.numVertices   = t_Mesh.numVertices;
+        t_Out.numIndices    = t_Mesh.numIndices;
+        t_Out.numTris       = t_Mesh.numTris;
+    }
+
+    // exact-bits vertex key, used to join identical vertices
+    struct VertexKey
+    {
+        f32 m_Data[8];
+
+        bool operator == (const VertexKey & t_Other) const
+        {
+            return memcmp(m_Data, t_Other.m_Data, sizeof(m_Data)) == 0;
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator () (const VertexKey & t_Key) const
+        {
+            u32 words[8];
+            memcpy(words, t_Key.m_Data, sizeof(words));
+            u32 hash = 2166136261u;
+            for (int i = 0; i < 8; ++i)
+                hash = (hash ^ words[i]) * 16777619u;
+            return hash;
+        }
+    };
+
+    static VertexKey MakeKey(const Vertex & t_Vertex)
+    {
+        VertexKey key;
+        memcpy(&key.m_Data[0], &t_Vertex.pos, sizeof(f32) * 3);
+        memcpy(&key.m_Data[3], &t_Vertex.nrm, sizeof(f32) * 3);
+        memcpy(&key.m_Data[6], &t_Vertex.uv, sizeof(f32) * 2);
+        return key;
+    }
+
+    // ==========================
+    // OBJ
+    // ==========================
+
+    // relative (negative) OBJ indices are stored chunk-local with this bias
+    // subtracted, so they stay apart from absolute ones (>= 0) and "none" (-1)
+    static const s32 s_ObjRelativeBias = 1 << 30;
+
+    struct ObjChunk
+    {
+        const char *        m_Begin;
+        const char *        m_End;
+        std::vector<f32>    m_Positions;   // xyz
+        std::vector<f32>    m_UVs;         // uv
+        std::vector<f32>    m_Normals;     // xyz
+        std::vector<s32>    m_Corners;     // v, vt, vn per triangle corner
+        bool                m_Valid;
+    };
+
+    // a v/vt/vn triple, keys the vertices that sit on UV or normal seams
+    struct ObjCornerKey
+    {
+        s32 m_V, m_T, m_N;
+
+        bool operator == (const ObjCornerKey & t_Other) const
+        {
+            return m_V == t_Other.m_V && m_T == t_Other.m_T && m_N == t_Other.m_N;
+        }
+    };
+
+    struct ObjCornerKeyHash
+    {
+        size_t operator () (const ObjCornerKey & t_Key) const
+        {
+            return (static_cast<size_t>(t_Key.m_V) * 73856093u) ^ 
+                   (static_cast<size_t>(t_Key.m_T) * 19349663u) ^ 
+                   (static_cast<size_t>(t_Key.m_N) * 83492791u);
+        }
+    };
+
+    static inline s32 EncodeObjIndex(s32 t_Index, u32 t_LocalCount)
+    {
+        if (t_Index > 0)
+            return t_Index - 1;
+        if (t_Index < 0)
+            return static_cast<s32>(t_LocalCount) + t_Index - s_ObjRelativeBias;
+        return -1;
+    }
+
+    static inline s32 DecodeObjIndex(s32 t_Index, u32 t_ChunkBase)
+    {
+        if (t_Index >= -1)
+            return t_Index;
+        return static_cast<s32>(t_ChunkBase) + t_Index + s_ObjRelativeBias;
+    }
+
+    static void ParseObjChunk(ObjChunk & t_Chunk)
+    {
+        const char * p = t_Chunk.m_Begin;
+        const char * end = t_Chunk.m_End;
+        std::vector<s32> polygon;
+        t_Chunk.m_Valid = true;
+
+        while (p < end)
+        {
+            const char * lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+            if (!lineEnd)
+                lineEnd = end;
+
+            p = SkipBlanks(p, lineEnd);
+            if (lineEnd - p > 1 && p[0] == 'v')
+            {
+                f32 value[3] = { 0.f, 0.f, 0.f };
+                if (p[1] == ' ' || p[1] == '\t')
+                {
+                    const char * q = p + 1;
+                    for (int i = 0; i < 3; ++i)
+                        q = ParseFloat(q, lineEnd, value[i]);
+                    t_Chunk.m_Positions.insert(t_Chunk.m_Positions.end(), value, value + 3);
+                }
+                else if (p[1] == 't')
+                {
+                    const char * q = p + 2;
+                    for (int i = 0; i < 2; ++i)
+                        q = ParseFloat(q, lineEnd, value[i]);
+                    t_Chunk.m_UVs.insert(t_Chunk.m_UVs.end(), value, value + 2);
+                }
+                else if (p[1] == 'n')
+                {
+                    const char * q = p + 2;
+                    for (int i = 0; i < 3; ++i)
+                        q = ParseFloat(q, lineEnd, value[i]);
+                    t_Chunk.m_Normals.insert(t_Chunk.m_Normals.end(), value, value + 3);
+                }
+            }
+            else if (lineEnd - p > 1 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+            {
+                u32 positions = t_Chunk.m_Positions.size() / 3;
+                u32 uvs = t_Chunk.m_UVs.size() / 2;
+                u32 normals = t_Chunk.m_Normals.size() / 3;
+
+                polygon.clear();
+                const char * q = SkipBlanks(p + 1, lineEnd);
+                while (q != lineEnd)
+                {
+                    s32 v = 0, t = 0, n = 0;
+                    const char * next = ParseInt(q, lineEnd, v);
+                    if (next == q)
+                    {
+                        t_Chunk.m_Valid = false;
+                        return;
+                    }
+                    q = next;
+                    if (q != lineEnd && *q == '/')
+                    {
+                        q = ParseInt(q + 1, lineEnd, t);
+                        if (q != lineEnd && *q == '/')
+                            q = ParseInt(q + 1, lineEnd, n);
+                    }
+                    polygon.push_back(EncodeObjIndex(v, positions));
+                    polygon.push_back(EncodeObjIndex(t, uvs));
+                    polygon.push_back(EncodeObjIndex(n, normals));
+                    q = SkipBlanks(q, lineEnd);
+                }
+
+                // fan triangulation, as aiProcess_Triangulate does for convex faces
+                for (u32 i = 2; i < polygon.size() / 3; ++i)
+                {
+                    t_Chunk.m_Corners.insert(t_Chunk.m_Corners.end(), &polygon[0], &polygon[0] + 3);
+                    t_Chunk.m_Corners.insert(t_Chunk.m_Corners.end(), &polygon[(i - 1) * 3], &polygon[(i - 1) * 3] + 3);
+                    t_Chunk.m_Corners.insert(t_Chunk.m_Corners.end(), &polygon[i * 3], &polygon[i * 3] + 3);
+                }
+            }
+
+            p = lineEnd + 1;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool ReadOBJ(const str & t_FileName, Mesh & t_Out)
+
+    \brief
+        Maps the file, parses line-aligned chunks of it in parallel, then
+        stitches the chunks and joins identical v/vt/vn corners into
+        vertices.
+    */
+    /*************************************************************************/
+    bool ReadOBJ(const str & t_FileName, Mesh & t_Out)
+    {
+        Mesh t_Mesh;
+        MappedFile t_File;
+        if (!t_File.Open(t_FileName))
+            return false;
+
+        const char * t_Data = reinterpret_cast<const char *>(t_File.GetData());
+        const char * t_End = t_Data + t_File.GetSize();
+
+        // line-aligned chunks, a few per thread so uneven chunks even out
+        const u64 t_MinChunk = 1 << 20;
+        u64 t_ChunkSize = std::max<u64>(t_MinChunk, t_File.GetSize() / (omp_get_max_threads() * 4));
+        std::vector<ObjChunk> t_Chunks;
+        for (const char * p = t_Data; p < t_End;)
+        {
+            const char * t_Split = (static_cast<u64>(t_End - p) > t_ChunkSize) ? p + t_ChunkSize : t_End;
+            const char * t_LineEnd = static_cast<const char *>(memchr(t_Split, '\n', t_End - t_Split));
+            t_Split = t_LineEnd ? t_LineEnd + 1 : t_End;
+
+            ObjChunk t_Chunk;
+            t_Chunk.m_Begin = p;
+            t_Chunk.m_End = t_Split;
+            t_Chunks.push_back(t_Chunk);
+            p = t_Split;
+        }
+
+        s32 t_ChunkCount = static_cast<s32>(t_Chunks.size());
+#pragma omp parallel for schedule(dynamic, 1)
+        for (s32 i = 0; i < t_ChunkCount; ++i)
+            ParseObjChunk(t_Chunks[i]);
+
+        // chunk offsets into the file-wide arrays
+        std::vector<u32> t_PositionBase(t_ChunkCount + 1, 0), t_UVBase(t_ChunkCount + 1, 0);
+        std::vector<u32> t_NormalBase(t_ChunkCount + 1, 0), t_CornerBase(t_ChunkCount + 1, 0);
+        for (s32 i = 0; i < t_ChunkCount; ++i)
+        {
+            if (!t_Chunks[i].m_Valid)
+                return false;
+            t_PositionBase[i + 1]   = t_PositionBase[i] + t_Chunks[i].m_Positions.size() / 3;
+            t_UVBase[i + 1]         = t_UVBase[i] + t_Chunks[i].m_UVs.size() / 2;
+            t_NormalBase[i + 1]     = t_NormalBase[i] + t_Chunks[i].m_Normals.size() / 3;
+            t_CornerBase[i + 1]     = t_CornerBase[i] + t_Chunks[i].m_Corners.size() / 3;
+        }
+
+        u32 t_PositionCount = t_PositionBase[t_ChunkCount];
+        u32 t_UVCount = t_UVBase[t_ChunkCount];
+        u32 t_NormalCount = t_NormalBase[t_ChunkCount];
+        u32 t_CornerCount = t_CornerBase[t_ChunkCount];
+        if (t_PositionCount == 0 || t_CornerCount == 0)
+            return false;
+
+        std::vector<f32> t_Positions(t_PositionCount * 3), t_UVs(t_UVCount * 2), t_Normals(t_NormalCount * 3);
+        std::vector<s32> t_Corners(t_CornerCount * 3);
+        s32 t_Invalid = 0;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+: t_Invalid)
+        for (s32 i = 0; i < t_ChunkCount; ++i)
+        {
+            const ObjChunk & t_Chunk = t_Chunks[i];
+            std::copy(t_Chunk.m_Positions.begin(), t_Chunk.m_Positions.end(), t_Positions.begin() + t_PositionBase[i] * 3);
+            std::copy(t_Chunk.m_UVs.begin(), t_Chunk.m_UVs.end(), t_UVs.begin() + t_UVBase[i] * 2);
+            std::copy(t_Chunk.m_Normals.begin(), t_Chunk.m_Normals.end(), t_Normals.begin() + t_NormalBase[i] * 3);
+
+            s32 * t_Out = &t_Corners[0] + t_CornerBase[i] * 3;
+            for (u32 j = 0; j < t_Chunk.m_Corners.size(); j += 3)
+            {
+                s32 v = DecodeObjIndex(t_Chunk.m_Corners[j], t_PositionBase[i]);
+                s32 t = DecodeObjIndex(t_Chunk.m_Corners[j + 1], t_UVBase[i]);
+                s32 n = DecodeObjIndex(t_Chunk.m_Corners[j + 2], t_NormalBase[i]);
+
+                if (v < 0 || v >= static_cast<s32>(t_PositionCount) ||
+                    t >= static_cast<s32>(t_UVCount) || n >= static_cast<s32>(t_NormalCount))
+                    ++t_Invalid;
+                t_Out[j] = v;
+                t_Out[j + 1] = t;
+                t_Out[j + 2] = n;
+            }
+        }
+        if (t_Invalid)
+            return false;
+        t_Chunks.clear();
+
+        // join identical corners; most positions only ever pair with one
+        // vt/vn, so that case is a direct lookup and only seams hit the map
+        std::vector<s32> t_FirstVertex(t_PositionCount, -1);
+        std::vector<std::pair<s32, s32> > t_VertexAttributes;
+        std::unordered_map<ObjCornerKey, s32, ObjCornerKeyHash> t_SeamVertices;
+        bool t_HasNormals = false, t_HasUVs = false;
+
+        t_Mesh.vertexBuffer.clear();
+        t_Mesh.indexBuffer.clear();
+        t_Mesh.vertexBuffer.reserve(t_PositionCount);
+        t_Mesh.indexBuffer.reserve(t_CornerCount);
+        t_VertexAttributes.reserve(t_PositionCount);
+
+        for (u32 i = 0; i < t_CornerCount; ++i)
+        {
+            s32 v = t_Corners[i * 3], t = t_Corners[i * 3 + 1], n = t_Corners[i * 3 + 2];
+            s32 t_Vertex = t_FirstVertex[v];
+
+            if (t_Vertex != -1 && (t_VertexAttributes[t_Vertex].first != t || t_VertexAttributes[t_Vertex].second != n))
+            {
+                ObjCornerKey t_Key = { v, t, n };
+                std::pair<std::unordered_map<ObjCornerKey, s32, ObjCornerKeyHash>::iterator, bool> t_Seam = 
+                    t_SeamVertices.insert(std::make_pair(t_Key, static_cast<s32>(t_Mesh.vertexBuffer.size())));
+                t_Vertex = t_Seam.second ? -1 : t_Seam.first->second;
+            }
+
+            if (t_Vertex == -1)
+            {
+                Vertex t_New;
+                t_New.pos = Vec3(t_Positions[v * 3], t_Positions[v * 3 + 1], t_Positions[v * 3 + 2]);
+                if (t >= 0)
+                    t_New.uv = Vec2(t_UVs[t * 2], t_UVs[t * 2 + 1]);
+                if (n >= 0)
+                    t_New.nrm = Vec3(t_Normals[n * 3], t_Normals[n * 3 + 1], t_Normals[n * 3 + 2]);
+                t_HasUVs = t_HasUVs || t >= 0;
+                t_HasNormals = t_HasNormals || n >= 0;
+
+                t_Vertex = t_Mesh.vertexBuffer.size();
+                if (t_FirstVertex[v] == -1)
+                    t_FirstVertex[v] = t_Vertex;
+                t_Mesh.vertexBuffer.push_back(t_New);
+                t_VertexAttributes.push_back(std::make_pair(t, n));
+            }
+            t_Mesh.indexBuffer.push_back(t_Vertex);
+        }
+
+        FinishMesh(t_Mesh, t_Out, t_HasNormals, t_HasUVs);
+        return true;
+    }
+
+    // ==========================
+    // PLY
+    // ==========================
+
+    enum PlyType { PLY_NONE, PLY_S8, PLY_U8, PLY_S16, PLY_U16, PLY_S32, PLY_U32, PLY_F32, PLY_F64 };
+
+    struct PlyProperty
+    {
+        str         m_Name;
+        PlyType     m_Type;        // value type, or item type of a list
+        PlyType     m_CountType;   // PLY_NONE unless this is a list
+    };
+
+    struct PlyElement
+    {
+        str                         m_Name;
+        u32                         m_Count;
+        std::vector<PlyProperty>    m_Properties;
+    };
+
+    static PlyType ParsePlyType(const str & t_Name)
+    {
+        if (t_Name == "char"   || t_Name == "int8")     return PLY_S8;
+        if (t_Name == "uchar"  || t_Name == "uint8")    return PLY_U8;
+        if (t_Name == "short"  || t_Name == "int16")    return PLY_S16;
+        if (t_Name == "ushort" || t_Name == "uint16")   return PLY_U16;
+        if (t_Name == "int"    || t_Name == "int32")    return PLY_S32;
+        if (t_Name == "uint"   || t_Name == "uint32")   return PLY_U32;
+        if (t_Name == "float"  || t_Name == "float32")  return PLY_F32;
+        if (t_Name == "double" || t_Name == "float64")  return PLY_F64;
+        return PLY_NONE;
+    }
+
+    static u32 PlyTypeSize(PlyType t_Type)
+    {
+        static const u32 s_Sizes[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+        return s_Sizes[t_Type];
+    }
+
+    static f64 ReadPlyValue(const u8 * t_Data, PlyType t_Type, bool t_Swap)
+    {
+        u8 bytes[8];
+        u32 size = PlyTypeSize(t_Type);
+        for (u32 i = 0; i < size; ++i)
+            bytes[i] = t_Swap ? t_Data[size - 1 - i] : t_Data[i];
+
+        switch (t_Type)
+        {
+            case PLY_S8:  { s8  v; memcpy(&v, bytes, 1); return v; }
+            case PLY_U8:  { u8  v; memcpy(&v, bytes, 1); return v; }
+            case PLY_S16: { s16 v; memcpy(&v, bytes, 2); return v; }
+            case PLY_U16: { u16 v; memcpy(&v, bytes, 2); return v; }
+            case PLY_S32: { s32 v; memcpy(&v, bytes, 4); return v; }
+            case PLY_U32: { u32 v; memcpy(&v, bytes, 4); return v; }
+            case PLY_F32: { f32 v; memcpy(&v, bytes, 4); return v; }
+            case PLY_F64: { f64 v; memcpy(&v, bytes, 8); return v; }
+            default:      return 0.0;
+        }
+    }
+
+    static bool ParsePlyHeader(const char * t_Data, const char * t_End, std::vector<PlyElement> & t_Elements,
+                               bool & t_Swap, const u8 *& t_Body)
+    {
+        const char * t_HeaderEnd = nullptr;
+        static const char s_EndHeader[] = "end_header";
+        for (const char * p = t_Data; p + sizeof(s_EndHeader) <= t_End && !t_HeaderEnd; ++p)
+        {
+            if (memcmp(p, s_EndHeader, sizeof(s_EndHeader) - 1) == 0)
+                t_HeaderEnd = p;
+        }
+        if (!t_HeaderEnd || memcmp(t_Data, "ply", 3) != 0)
+            return false;
+
+        const char * t_LineEnd = static_cast<const char *>(memchr(t_HeaderEnd, '\n', t_End - t_HeaderEnd));
+        if (!t_LineEnd)
+            return false;
+        t_Body = reinterpret_cast<const u8 *>(t_LineEnd + 1);
+
+        bool t_Binary = false;
+        std::istringstream t_Header(str(t_Data, t_HeaderEnd));
+        str t_Line;
+        while (std::getline(t_Header, t_Line))
+        {
+            std::istringstream t_Words(t_Line);
+            str t_Keyword;
+            t_Words >> t_Keyword;
+
+            if (t_Keyword == "format")
+            {
+                str t_Format;
+                t_Words >> t_Format;
+                t_Binary = (t_Format == "binary_little_endian" || t_Format == "binary_big_endian");
+                t_Swap = (t_Format == "binary_big_endian");
+            }
+            else if (t_Keyword == "element")
+            {
+                PlyElement t_Element;
+                t_Words >> t_Element.m_Name >> t_Element.m_Count;
+                t_Elements.push_back(t_Element);
+            }
+            else if (t_Keyword == "property")
+            {
+                if (t_Elements.empty())
+                    return false;
+
+                PlyProperty t_Property;
+                str t_Type;
+                t_Words >> t_Type;
+                if (t_Type == "list")
+                {
+                    str t_CountType, t_ItemType;
+                    t_Words >> t_CountType >> t_ItemType >> t_Property.m_Name;
+                    t_Property.m_CountType = ParsePlyType(t_CountType);
+                    t_Property.m_Type = ParsePlyType(t_ItemType);
+                    if (t_Property.m_CountType == PLY_NONE)
+                        return false;
+                }
+                else
+                {
+                    t_Words >> t_Property.m_Name;
+                    t_Property.m_Type = ParsePlyType(t_Type);
+                    t_Property.m_CountType = PLY_NONE;
+                }
+                if (t_Property.m_Type == PLY_NONE)
+                    return false;
+                t_Elements.back().m_Properties.push_back(t_Property);
+            }
+        }
+
+        // ASCII PLY is left to Assimp
+        return t_Binary;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool ReadPLY(const str & t_FileName, Mesh & t_Out)
+
+    \brief
+        Binary PLY (either byte order) straight from the mapped file.
+        Fixed-size vertex records are decoded in parallel; faces are
+        fan-triangulated.
+    */
+    /*************************************************************************/
+    bool ReadPLY(const str & t_FileName, Mesh & t_Out)
+    {
+        Mesh t_Mesh;
+        MappedFile t_File;
+        if (!t_File.Open(t_FileName))
+            return false;
+
+        const char * t_Data = reinterpret_cast<const char *>(t_File.GetData());
+        const u8 * t_End = t_File.GetData() + t_File.GetSize();
+
+        std::vector<PlyElement> t_Elements;
+        bool t_Swap = false;
+        const u8 * p = nullptr;
+        if (!ParsePlyHeader(t_Data, t_Data + t_File.GetSize(), t_Elements, t_Swap, p))
+            return false;
+
+        bool t_HasNormals = false, t_HasUVs = false, t_HasFaces = false;
+        t_Mesh.vertexBuffer.clear();
+        t_Mesh.indexBuffer.clear();
+
+        for (u32 e = 0; e < t_Elements.size(); ++e)
+        {
+            const PlyElement & t_Element = t_Elements[e];
+
+            // fixed record size, and where each property sits in it
+            bool t_Fixed = true;
+            u32 t_Stride = 0;
+            std::vector<u32> t_Offsets;
+            for (u32 i = 0; i < t_Element.m_Properties.size(); ++i)
+            {
+                t_Offsets.push_back(t_Stride);
+                t_Fixed = t_Fixed && t_Element.m_Properties[i].m_CountType == PLY_NONE;
+                t_Stride += PlyTypeSize(t_Element.m_Properties[i].m_Type);
+            }
+
+            if (t_Element.m_Name == "vertex")
+            {
+                if (!t_Fixed || static_cast<u64>(t_End - p) < static_cast<u64>(t_Stride) * t_Element.m_Count)
+                    return false;
+
+                // x y z, nx ny nz, then any of the usual UV spellings
+                static const char * s_Names[] = { "x", "y", "z", "nx", "ny", "nz", "u", "v", "s", "t", "texture_u", "texture_v" };
+                s32 t_Slot[12];
+                for (int k = 0; k < 12; ++k)
+                {
+                    t_Slot[k] = -1;
+                    for (u32 i = 0; i < t_Element.m_Properties.size(); ++i)
+                        if (t_Element.m_Properties[i].m_Name == s_Names[k])
+                            t_Slot[k] = i;
+                }
+                for (int k = 6; k < 12; k += 2)
+                {
+                    if (t_Slot[6] == -1 && t_Slot[k] != -1 && t_Slot[k + 1] != -1)
+                    {
+                        t_Slot[6] = t_Slot[k];
+                        t_Slot[7] = t_Slot[k + 1];
+                    }
+                }
+                if (t_Slot[0] == -1 || t_Slot[1] == -1 || t_Slot[2] == -1)
+                    return false;
+
+                t_HasNormals = t_Slot[3] != -1 && t_Slot[4] != -1 && t_Slot[5] != -1;
+                t_HasUVs = t_Slot[6] != -1 && t_Slot[7] != -1;
+
+                t_Mesh.vertexBuffer.resize(t_Element.m_Count);
+                const u8 * t_Records = p;
+                s32 t_Count = static_cast<s32>(t_Element.m_Count);
+#pragma omp parallel for
+                for (s32 i = 0; i < t_Count; ++i)
+                {
+                    const u8 * t_Record = t_Records + static_cast<u64>(i) * t_Stride;
+                    f32 t_Value[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        if (t_Slot[k] != -1)
+                            t_Value[k] = static_cast<f32>(ReadPlyValue(t_Record + t_Offsets[t_Slot[k]], t_Element.m_Properties[t_Slot[k]].m_Type, t_Swap));
+                    }
+
+                    Vertex & t_Vertex = t_Mesh.vertexBuffer[i];
+                    t_Vertex.pos = Vec3(t_Value[0], t_Value[1], t_Value[2]);
+                    t_Vertex.nrm = Vec3(t_Value[3], t_Value[4], t_Value[5]);
+                    t_Vertex.uv = Vec2(t_Value[6], t_Value[7]);
+                }
+                p += static_cast<u64>(t_Stride) * t_Element.m_Count;
+            }
+            else if (t_Fixed)
+            {
+                if (static_cast<u64>(t_End - p) < static_cast<u64>(t_Stride) * t_Element.m_Count)
+                    return false;
+                p += static_cast<u64>(t_Stride) * t_Element.m_Count;
+            }
+            else
+            {
+                bool t_IsFace = (t_Element.m_Name == "face");
+                t_HasFaces = t_HasFaces || t_IsFace;
+                if (t_IsFace)
+                    t_Mesh.indexBuffer.reserve(t_Mesh.indexBuffer.size() + t_Element.m_Count * 3);
+
+                std::vector<s32> t_Polygon;
+                for (u32 r = 0; r < t_Element.m_Count; ++r)
+                {
+                    for (u32 i = 0; i < t_Element.m_Properties.size(); ++i)
+                    {
+                        const PlyProperty & t_Property = t_Element.m_Properties[i];
+                        u32 t_ItemSize = PlyTypeSize(t_Property.m_Type);
+
+                        if (t_Property.m_CountType == PLY_NONE)
+                        {
+                            if (static_cast<u64>(t_End - p) < t_ItemSize)
+                                return false;
+                            p += t_ItemSize;
+                            continue;
+                        }
+
+                        u32 t_CountSize = PlyTypeSize(t_Property.m_CountType);
+                        if (static_cast<u64>(t_End - p) < t_CountSize)
+                            return false;
+                        u32 t_Items = static_cast<u32>(ReadPlyValue(p, t_Property.m_CountType, t_Swap));
+                        p += t_CountSize;
+                        if (static_cast<u64>(t_End - p) < static_cast<u64>(t_Items) * t_ItemSize)
+                            return false;
+
+                        if (t_IsFace && (t_Property.m_Name == "vertex_indices" || t_Property.m_Name == "vertex_index"))
+                        {
+                            t_Polygon.resize(t_Items);
+                            for (u32 k = 0; k < t_Items; ++k)
+                                t_Polygon[k] = static_cast<s32>(ReadPlyValue(p + k * t_ItemSize, t_Property.m_Type, t_Swap));
+                            for (u32 k = 2; k < t_Items; ++k)
+                            {
+                                t_Mesh.indexBuffer.push_back(t_Polygon[0]);
+                                t_Mesh.indexBuffer.push_back(t_Polygon[k - 1]);
+                                t_Mesh.indexBuffer.push_back(t_Polygon[k]);
+                            }
+                        }
+                        p += static_cast<u64>(t_Items) * t_ItemSize;
+                    }
+                }
+            }
+        }
+
+        if (!t_HasFaces || t_Mesh.vertexBuffer.empty() || t_Mesh.indexBuffer.empty())
+            return false;
+        for (u32 i = 0; i < t_Mesh.indexBuffer.size(); ++i)
+        {
+            if (t_Mesh.indexBuffer[i] < 0 || t_Mesh.indexBuffer[i] >= static_cast<s32>(t_Mesh.vertexBuffer.size()))
+                return false;
+        }
+
+        FinishMesh(t_Mesh, t_Out, t_HasNormals, t_HasUVs);
+        return true;
+    }
+
+    // ==========================
+    // STL
+    // ==========================
+
+    /*************************************************************************/
+    /*!
+    \fn bool ReadSTL(const str & t_FileName, Mesh & t_Out)
+
+    \brief
+        Binary STL from the mapped file. Each facet carries its own normal,
+        so corners are joined only where position and normal both match,
+        which keeps hard edges as Assimp's import does.
+    */
+    /*************************************************************************/
+    bool ReadSTL(const str & t_FileName, Mesh & t_Out)
+    {
+        Mesh t_Mesh;
+        MappedFile t_File;
+        if (!t_File.Open(t_FileName) || t_File.GetSize() < 84)
+            return false;
+
+        const u8 * t_Data = t_File.GetData();
+        u32 t_Triangles;
+        memcpy(&t_Triangles, t_Data + 80, sizeof(u32));
+
+        // an ASCII STL cannot have exactly this size in practice
+        static const u32 s_FacetSize = 50;
+        if (t_Triangles == 0 || t_File.GetSize() != 84 + static_cast<u64>(t_Triangles) * s_FacetSize)
+            return false;
+
+        std::vector<Vertex> t_Corners(t_Triangles * 3);
+        s32 t_Count = static_cast<s32>(t_Triangles);
+#pragma omp parallel for
+        for (s32 i = 0; i < t_Count; ++i)
+        {
+            f32 t_Facet[12];
+            memcpy(t_Facet, t_Data + 84 + static_cast<u64>(i) * s_FacetSize, sizeof(t_Facet));
+
+            Vec3 v0(t_Facet[3], t_Facet[4], t_Facet[5]);
+            Vec3 v1(t_Facet[6], t_Facet[7], t_Facet[8]);
+            Vec3 v2(t_Facet[9], t_Facet[10], t_Facet[11]);
+            Vec3 normal(t_Facet[0], t_Facet[1], t_Facet[2]);
+            if (Dot(normal, normal) == 0.f)
+            {
+                normal = Cross(v1 - v0, v2 - v0);
+                f32 length = glm::length(normal);
+                normal = (length > 0.f) ? normal / length : Vec3(0.f);
+            }
+
+            t_Corners[i * 3].pos = v0;
+            t_Corners[i * 3 + 1].pos = v1;
+            t_Corners[i * 3 + 2].pos = v2;
+            t_Corners[i * 3].nrm = t_Corners[i * 3 + 1].nrm = t_Corners[i * 3 + 2].nrm = normal;
+        }
+
+        std::unordered_map<VertexKey, s32, VertexKeyHash> t_Joined;
+        t_Joined.reserve(t_Corners.size());
+        t_Mesh.vertexBuffer.clear();
+        t_Mesh.indexBuffer.clear();
+        t_Mesh.vertexBuffer.reserve(t_Triangles);
+        t_Mesh.indexBuffer.reserve(t_Corners.size());
+
+        for (u32 i = 0; i < t_Corners.size(); ++i)
+        {
+            std::pair<std::unordered_map<VertexKey, s32, VertexKeyHash>::iterator, bool> t_Inserted =
+                t_Joined.insert(std::make_pair(MakeKey(t_Corners[i]), static_cast<s32>(t_Mesh.vertexBuffer.size())));
+            if (t_Inserted.second)
+                t_Mesh.vertexBuffer.push_back(t_Corners[i]);
+            t_Mesh.indexBuffer.push_back(t_Inserted.first->second);
+        }
+
+        FinishMesh(t_Mesh, t_Out, true, false);
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool ReadMeshNative(const str & t_FileName, Mesh & t_Mesh)
+
+    \brief
+        Dispatches to the native reader for the file's extension.
+
+    \return
+        false if there is no native reader for the file, or it declined it.
+    */
+    /*************************************************************************/
+    bool ReadMeshNative(const str & t_FileName, Mesh & t_Mesh)
+    {
+        size_t t_Dot = t_FileName.find_last_of('.');
+        if (t_Dot == str::npos)
+            return false;
+
+        str t_Extension = t_FileName.substr(t_Dot + 1);
+        std::transform(t_Extension.begin(), t_Extension.end(), t_Extension.begin(), ::tolower);
+
+        if (t_Extension == "obj")
+            return ReadOBJ(t_FileName, t_Mesh);
+        if (t_Extension == "ply")
+            return ReadPLY(t_FileName, t_Mesh);
+        if (t_Extension == "stl")
+            return ReadSTL(t_FileName, t_Mesh);
+        return false;
+    }
+}
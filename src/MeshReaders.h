@@ -0,0 +1,38 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshReaders.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MESHREADERS_H_
+#define _MESHREADERS_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Mesh.hpp"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Native readers for the formats we scan into, filling Mesh directly
+    // with the same result as the Assimp import in Model::LoadModel
+    // (triangulated, identical vertices joined, tangents when the file
+    // has both normals and UVs).
+    // Each returns false for anything it does not handle (ASCII PLY/STL,
+    // unknown layouts) and leaves t_Mesh untouched, so the caller can fall
+    // back to Assimp.
+
+    bool    ReadOBJ(const str & t_FileName, Mesh & t_Mesh);
+    bool    ReadPLY(const str & t_FileName, Mesh & t_Mesh);
+    bool    ReadSTL(const str & t_FileName, Mesh & t_Mesh);
+
+    // picks a reader by file extension
+    bool    ReadMeshNative(const str & t_FileName, Mesh & t_Mesh);
+}
+
+#endif
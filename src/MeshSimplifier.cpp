@@ -0,0 +1,403 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshSimplifier.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "MeshSimplifier.h"
+
+namespace Proto
+{
+    namespace
+    {
+        const u32 MAX_LOD_LEVELS        = 6;
+        const u32 MIN_LOD_TRIANGLES     = 256;
+        // a level has to drop at least this share of triangles to be kept
+        const f32 MIN_LOD_REDUCTION     = 0.1f;
+
+        // symmetric 4x4 plane quadric, plus the area it was built from
+        struct Quadric
+        {
+            f64 a00, a01, a02, a11, a12, a22;
+            f64 b0, b1, b2;
+            f64 c;
+            f64 w;
+
+            Quadric() : a00(0), a01(0), a02(0), a11(0), a12(0), a22(0), b0(0), b1(0), b2(0), c(0), w(0) {}
+
+            Quadric & operator += (const Quadric & r)
+            {
+                a00 += r.a00; a01 += r.a01; a02 += r.a02; a11 += r.a11; a12 += r.a12; a22 += r.a22;
+                b0 += r.b0; b1 += r.b1; b2 += r.b2;
+                c += r.c;
+                w += r.w;
+                return *this;
+            }
+        };
+
+        Quadric PlaneQuadric(const vec3 & t_V0, const vec3 & t_V1, const vec3 & t_V2)
+        {
+            Quadric q;
+            vec3 normal = Cross(t_V1 - t_V0, t_V2 - t_V0);
+            f64 area = glm::length(normal);
+            if (area <= 0.0)
+                return q;
+
+            f64 nx = normal.x / area, ny = normal.y / area, nz = normal.z / area;
+            f64 d = -(nx * t_V0.x + ny * t_V0.y + nz * t_V0.z);
+            area *= 0.5;
+
+            q.a00 = area * nx * nx; q.a01 = area * nx * ny; q.a02 = area * nx * nz;
+            q.a11 = area * ny * ny; q.a12 = area * ny * nz; q.a22 = area * nz * nz;
+            q.b0 = area * nx * d; q.b1 = area * ny * d; q.b2 = area * nz * d;
+            q.c = area * d * d;
+            q.w = area;
+            return q;
+        }
+
+        // mean squared distance of t_Point to the planes of t_Q
+        f32 QuadricError(const Quadric & t_Q, const vec3 & t_Point)
+        {
+            if (t_Q.w <= 0.0)
+                return 0.f;
+
+            f64 x = t_Point.x, y = t_Point.y, z = t_Point.z;
+            f64 error = t_Q.a00 * x * x + t_Q.a11 * y * y + t_Q.a22 * z * z
+                      + 2.0 * (t_Q.a01 * x * y + t_Q.a02 * x * z + t_Q.a12 * y * z)
+                      + 2.0 * (t_Q.b0 * x + t_Q.b1 * y + t_Q.b2 * z)
+                      + t_Q.c;
+            return static_cast<f32>(std::max(error, 0.0) / t_Q.w);
+        }
+
+        struct Collapse
+        {
+            u32 m_From;
+            u32 m_To;
+            f32 m_Cost;
+
+            bool operator < (const Collapse & r) const
+            {
+                return m_Cost < r.m_Cost;
+            }
+        };
+
+        // marks every vertex on an open edge or sharing its position with
+        // another vertex (a UV/normal seam)
+        void FindLockedVertices(const PositionBufferType & t_Positions, const IndexBufferType & t_Indices,
+                                std::vector<u8> & t_Locked)
+        {
+            u32 vertexCount = t_Positions.size();
+            t_Locked.assign(vertexCount, 0);
+
+            std::vector<u64> edges;
+            edges.reserve(t_Indices.size());
+            for (u32 i = 0; i + 2 < t_Indices.size(); i += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    u64 a = t_Indices[i + e], b = t_Indices[i + (e + 1) % 3];
+                    edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            for (u32 i = 0; i < edges.size();)
+            {
+                u32 j = i + 1;
+                while (j < edges.size() && edges[j] == edges[i])
+                    ++j;
+                if (j - i == 1)
+                {
+                    t_Locked[static_cast<u32>(edges[i] >> 32)] = 1;
+                    t_Locked[static_cast<u32>(edges[i] & 0xFFFFFFFFu)] = 1;
+                }
+                i = j;
+            }
+
+            std::vector<u32> order(vertexCount);
+            for (u32 i = 0; i < vertexCount; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&t_Positions](u32 a, u32 b)
+            {
+                return memcmp(&t_Positions[a], &t_Positions[b], sizeof(vec3)) < 0;
+            });
+            for (u32 i = 1; i < vertexCount; ++i)
+            {
+                if (memcmp(&t_Positions[order[i - 1]], &t_Positions[order[i]], sizeof(vec3)) == 0)
+                    t_Locked[order[i - 1]] = t_Locked[order[i]] = 1;
+            }
+        }
+
+        bool FlipsTriangle(const PositionBufferType & t_Positions, u32 t_A, u32 t_B, u32 t_C, u32 t_From, u32 t_To)
+        {
+            const vec3 & a = t_Positions[t_A];
+            const vec3 & b = t_Positions[t_B];
+            const vec3 & c = t_Positions[t_C];
+            vec3 before = Cross(b - a, c - a);
+
+            const vec3 & a1 = t_Positions[t_A == t_From ? t_To : t_A];
+            const vec3 & b1 = t_Positions[t_B == t_From ? t_To : t_B];
+            const vec3 & c1 = t_Positions[t_C == t_From ? t_To : t_C];
+            vec3 after = Cross(b1 - a1, c1 - a1);
+
+            return Dot(before, after) <= 0.f;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn f32 SimplifyMesh(const PositionBufferType & t_Positions,
+                         const IndexBufferType & t_Indices,
+                         u32 t_TargetIndexCount, IndexBufferType & t_Result,
+                         std::vector<u32> & t_Remap)
+
+    \brief
+        Collapses edges, cheapest first, until t_Result has at most
+        t_TargetIndexCount indices or nothing more can be collapsed.
+        Each pass costs every edge in parallel, then takes collapses in
+        cost order as long as they do not touch a vertex already changed
+        in the pass and do not flip any triangle.
+
+    \param t_Remap
+        Receives, for every vertex, the vertex it was collapsed into, or
+        itself if it was kept.
+
+    \return
+        The largest collapse error, as an object-space distance.
+    */
+    /*************************************************************************/
+    f32 SimplifyMesh(const PositionBufferType & t_Positions, const IndexBufferType & t_Indices,
+                     u32 t_TargetIndexCount, IndexBufferType & t_Result, std::vector<u32> & t_Remap)
+    {
+        u32 vertexCount = t_Positions.size();
+        t_Result.assign(t_Indices.begin(), t_Indices.begin() + (t_Indices.size() - t_Indices.size() % 3));
+        t_Remap.resize(vertexCount);
+        for (u32 i = 0; i < vertexCount; ++i)
+            t_Remap[i] = i;
+
+        std::vector<u8> locked;
+        FindLockedVertices(t_Positions, t_Result, locked);
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (u32 i = 0; i < t_Result.size(); i += 3)
+        {
+            Quadric q = PlaneQuadric(t_Positions[t_Result[i]], t_Positions[t_Result[i + 1]], t_Positions[t_Result[i + 2]]);
+            quadrics[t_Result[i]] += q;
+            quadrics[t_Result[i + 1]] += q;
+            quadrics[t_Result[i + 2]] += q;
+        }
+
+        f32 maxError = 0.f;
+        std::vector<u32> triStart, triList, step(vertexCount);
+        std::vector<u8> touched;
+        std::vector<Collapse> collapses;
+
+        while (t_Result.size() > t_TargetIndexCount)
+        {
+            u32 triCount = t_Result.size() / 3;
+
+            // triangles around every vertex, in compressed row form
+            triStart.assign(vertexCount + 1, 0);
+            for (u32 i = 0; i < t_Result.size(); ++i)
+                ++triStart[t_Result[i] + 1];
+            for (u32 i = 0; i < vertexCount; ++i)
+                triStart[i + 1] += triStart[i];
+            triList.resize(t_Result.size());
+            {
+                std::vector<u32> cursor(triStart.begin(), triStart.end() - 1);
+                for (u32 i = 0; i < t_Result.size(); ++i)
+                    triList[cursor[t_Result[i]]++] = i / 3;
+            }
+
+            // every interior edge is seen once, from the triangle where a < b;
+            // open edges only have locked ends and are skipped either way
+            collapses.resize(triCount * 3);
+            s32 total = static_cast<s32>(triCount);
+#pragma omp parallel for
+            for (s32 t = 0; t < total; ++t)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    Collapse & collapse = collapses[t * 3 + e];
+                    u32 a = t_Result[t * 3 + e], b = t_Result[t * 3 + (e + 1) % 3];
+                    collapse.m_Cost = FLT_MAX;
+                    if (a >= b)
+                        continue;
+
+                    Quadric q = quadrics[a];
+                    q += quadrics[b];
+                    if (!locked[a])
+                    {
+                        collapse.m_From = a; collapse.m_To = b;
+                        collapse.m_Cost = QuadricError(q, t_Positions[b]);
+                    }
+                    if (!locked[b])
+                    {
+                        f32 cost = QuadricError(q, t_Positions[a]);
+                        if (cost < collapse.m_Cost)
+                        {
+                            collapse.m_From = b; collapse.m_To = a;
+                            collapse.m_Cost = cost;
+                        }
+                    }
+                }
+            }
+
+            u32 candidates = 0;
+            for (u32 i = 0; i < collapses.size(); ++i)
+            {
+                if (collapses[i].m_Cost != FLT_MAX)
+                    collapses[candidates++] = collapses[i];
+            }
+            collapses.resize(candidates);
+            std::sort(collapses.begin(), collapses.end());
+
+            // take the cheapest collapses that keep the pass independent
+            for (u32 i = 0; i < vertexCount; ++i)
+                step[i] = i;
+            touched.assign(vertexCount, 0);
+            u32 removeTarget = (t_Result.size() - t_TargetIndexCount) / 3;
+            u32 removed = 0, applied = 0;
+
+            for (u32 i = 0; i < collapses.size() && removed < removeTarget; ++i)
+            {
+                const Collapse & collapse = collapses[i];
+                u32 from = collapse.m_From, to = collapse.m_To;
+                if (touched[from] || touched[to])
+                    continue;
+
+                bool valid = true;
+                u32 shared = 0;
+                for (u32 j = triStart[from]; j < triStart[from + 1] && valid; ++j)
+                {
+                    u32 tri = triList[j] * 3;
+                    u32 a = t_Result[tri], b = t_Result[tri + 1], c = t_Result[tri + 2];
+                    if (a == to || b == to || c == to)
+                        ++shared;
+                    else
+                        valid = !FlipsTriangle(t_Positions, a, b, c, from, to);
+                }
+                if (!valid)
+                    continue;
+
+                // freeze the one-ring so later checks in this pass stay exact
+                for (u32 j = triStart[from]; j < triStart[from + 1]; ++j)
+                {
+                    u32 tri = triList[j] * 3;
+                    touched[t_Result[tri]] = touched[t_Result[tri + 1]] = touched[t_Result[tri + 2]] = 1;
+                }
+                touched[to] = 1;
+
+                step[from] = to;
+                quadrics[to] += quadrics[from];
+                maxError = std::max(maxError, collapse.m_Cost);
+                removed += shared;
+                ++applied;
+            }
+            if (applied == 0)
+                break;
+
+            // apply the pass and drop the triangles that collapsed
+            u32 kept = 0;
+            for (u32 i = 0; i < t_Result.size(); i += 3)
+            {
+                u32 a = step[t_Result[i]], b = step[t_Result[i + 1]], c = step[t_Result[i + 2]];
+                if (a == b || b == c || a == c)
+                    continue;
+                t_Result[kept++] = a;
+                t_Result[kept++] = b;
+                t_Result[kept++] = c;
+            }
+            t_Result.resize(kept);
+
+            s32 vertices = static_cast<s32>(vertexCount);
+#pragma omp parallel for
+            for (s32 i = 0; i < vertices; ++i)
+                t_Remap[i] = step[t_Remap[i]];
+        }
+
+        return std::sqrt(maxError);
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void BuildMeshLODs(Mesh & t_Mesh)
+
+    \brief
+        Builds each level from the previous one, part by part, aiming at
+        half the triangles. Stops when a level would be too small or would
+        barely shrink. Level errors add up, so each bounds the distance to
+        the full mesh.
+    */
+    /*************************************************************************/
+    void BuildMeshLODs(Mesh & t_Mesh)
+    {
+        t_Mesh.lods.clear();
+        t_Mesh.lodIndexBuffer.clear();
+
+        const PositionBufferType & positions = t_Mesh.positionBuffer;
+        if (positions.empty() || t_Mesh.indexBuffer.size() < 3 * MIN_LOD_TRIANGLES)
+            return;
+
+        // current level, per draw range
+        MeshPartBufferType ranges(t_Mesh.parts);
+        if (ranges.empty())
+        {
+            MeshPart whole = { 0, static_cast<u32>(t_Mesh.indexBuffer.size()), 0 };
+            ranges.push_back(whole);
+        }
+        std::vector<IndexBufferType> levelIndices(ranges.size());
+        for (u32 p = 0; p < ranges.size(); ++p)
+        {
+            IndexBufferType::const_iterator first = t_Mesh.indexBuffer.begin() + ranges[p].indexStart;
+            levelIndices[p].assign(first, first + ranges[p].indexCount);
+        }
+
+        std::vector<u32> remap(positions.size()), stepRemap;
+        for (u32 i = 0; i < remap.size(); ++i)
+            remap[i] = i;
+
+        u32 indexCount = t_Mesh.indexBuffer.size();
+        f32 error = 0.f;
+        IndexBufferType simplified;
+
+        for (u32 level = 0; level < MAX_LOD_LEVELS && indexCount >= 6 * MIN_LOD_TRIANGLES; ++level)
+        {
+            u32 newCount = 0;
+            f32 levelError = 0.f;
+            for (u32 p = 0; p < levelIndices.size(); ++p)
+            {
+                u32 target = (levelIndices[p].size() / 6) * 3;
+                levelError = std::max(levelError, SimplifyMesh(positions, levelIndices[p], target, simplified, stepRemap));
+                levelIndices[p].swap(simplified);
+                newCount += levelIndices[p].size();
+
+                // vertices outside this part map to themselves
+                for (u32 i = 0; i < remap.size(); ++i)
+                    remap[i] = stepRemap[remap[i]];
+            }
+
+            if (newCount > indexCount * (1.f - MIN_LOD_REDUCTION))
+                break;
+
+            indexCount = newCount;
+            error += levelError;
+
+            MeshLOD lod;
+            lod.error = error;
+            lod.vertexRemap = remap;
+            for (u32 p = 0; p < levelIndices.size(); ++p)
+            {
+                MeshPart part = { static_cast<u32>(t_Mesh.lodIndexBuffer.size()),
+                                  static_cast<u32>(levelIndices[p].size()),
+                                  ranges[p].materialIndex };
+                t_Mesh.lodIndexBuffer.insert(t_Mesh.lodIndexBuffer.end(), levelIndices[p].begin(), levelIndices[p].end());
+                if (part.indexCount)
+                    lod.parts.push_back(part);
+            }
+            t_Mesh.lods.push_back(lod);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      MeshSimplifier.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _MESHSIMPLIFIER_H_
+#define _MESHSIMPLIFIER_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Mesh.hpp"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Quadric error metric simplification (Garland & Heckbert), restricted
+    // to collapsing a vertex onto one of its neighbours. A simplified mesh
+    // is therefore only a new index buffer over the same vertices.
+    // Border and seam vertices never move, so levels keep their outline
+    // and UV seams.
+
+    f32     SimplifyMesh(const PositionBufferType & t_Positions, const IndexBufferType & t_Indices,
+                         u32 t_TargetIndexCount, IndexBufferType & t_Result, std::vector<u32> & t_Remap);
+
+    // Fills t_Mesh.lods/lodIndexBuffer, halving the triangle count per level.
+    // Run after OptimizeMesh, as the levels index the final vertex order.
+    void    BuildMeshLODs(Mesh & t_Mesh);
+}
+
+#endif
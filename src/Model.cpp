@@ -7,6 +7,13 @@
 #include "Assimp/assimp.hpp"       // C++ importer interface
 #include "Assimp/aipostprocess.h"
 #include "Model.h"
+#include "MeshOptimizer.h"
+#include "MeshBinary.h"
+#include "MeshReaders.h"
+#include "MeshSimplifier.h"
+#include "TangentSpace.h"
+#include "graphics.hpp"
+#include "HeatMapWorker.h"
 #include <map>
 extern std::map<str, Mesh*> mapDebugMesh;
 
@@ -14,20 +21,26 @@ namespace Proto
 {
     /*************************************************************************/
     /*!
-    \fn Model::Model(const str & t_FileName)
+    \fn Model::Model(const str & t_FileName, bool t_BindNow)
 
     \brief
         This is the constructor of the Model class.
 
     \param t_FileName
         This is the file name of the object model.
+
+    \param t_BindNow
+        When false only the CPU side is loaded, so the model can be built
+        off the GL thread; BindModel must then be called on the GL thread.
     */
     /*************************************************************************/
-    Model::Model(const str & t_FileName):   m_FileName(t_FileName)
+    Model::Model(const str & t_FileName, bool t_BindNow):   m_FileName(t_FileName), m_IsLoaded(false), m_HasCachedBounds(false), m_HasData(false), m_ObjMesh(nullptr)
     {
-		m_IsLoaded = LoadModel();
-        if(!m_IsLoaded)
+        m_HasData = LoadModelData();
+        if(!m_HasData)
             std::cout << "Model.cpp: Unable to load "<<t_FileName<<"!\n";
+        else if(t_BindNow)
+            BindModel();
     }
 
     /*************************************************************************/
@@ -41,7 +54,7 @@ namespace Proto
         This is the model mesh to copy over.
     */
     /*************************************************************************/
-    Model::Model(Mesh & t_Mesh)
+    Model::Model(Mesh & t_Mesh): m_HasCachedBounds(false), m_HasData(true)
     {
 		m_ObjMesh     = &t_Mesh;
 		m_IsLoaded    = true;
@@ -80,21 +93,29 @@ namespace Proto
 
 		glGenBuffers(1, &m_ObjMesh->VBO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_ObjMesh->VBO);
-		glBufferData(GL_ARRAY_BUFFER, m_ObjMesh->vertexBuffer.size() * sizeof(m_ObjMesh->vertexBuffer[0]), &m_ObjMesh->vertexBuffer[0], GL_DYNAMIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, m_ObjMesh->vertexBuffer.size() * sizeof(m_ObjMesh->vertexBuffer[0]), &m_ObjMesh->vertexBuffer[0], GL_STATIC_DRAW);
 
+		// the simplified levels share the IBO, after the full resolution indices
+		const size_t indexBytes = m_ObjMesh->indexBuffer.size() * sizeof(m_ObjMesh->indexBuffer[0]);
+		const size_t lodIndexBytes = m_ObjMesh->lodIndexBuffer.size() * sizeof(m_ObjMesh->indexBuffer[0]);
 		glGenBuffers(1, &m_ObjMesh->IBO);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ObjMesh->IBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_ObjMesh->indexBuffer.size() * sizeof(m_ObjMesh->indexBuffer[0]), &m_ObjMesh->indexBuffer[0], GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes + lodIndexBytes, nullptr, GL_STATIC_DRAW);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexBytes, &m_ObjMesh->indexBuffer[0]);
+		if (lodIndexBytes)
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, lodIndexBytes, &m_ObjMesh->lodIndexBuffer[0]);
 
 		const int stride = sizeof(Vertex);
-		const VertexLayout *layout = vLayout;
 
-		while (layout->size)
+		for (int i = 0; i < numAttribs; ++i)
 		{
+			const VertexLayout *layout = &vLayout[i];
             glEnableVertexAttribArray(layout->location);
             glVertexAttribPointer(layout->location, layout->size, layout->type, layout->normalized, stride, (void*)layout->offset);
-			layout++;
 		}
+
+		// heatmap values are streamed separately from the static vertex data
+		SetUpHeatMapStream(*m_ObjMesh);
 		glBindVertexArray(0);
     }
 
@@ -105,25 +126,132 @@ namespace Proto
     \fn bool Model::LoadModel()
 
     \brief
-        This function loads the model object.
+        This function loads the model object and binds its VAO.
     */
     /*************************************************************************/
     bool Model::LoadModel()
+    {
+        m_HasData = LoadModelData();
+        if (m_HasData)
+            BindModel();
+        return m_HasData;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void Model::BindModel()
+
+    \brief
+        GL half of loading, uploads the loaded mesh. Must run on the GL 
+        thread.
+    */
+    /*************************************************************************/
+    void Model::BindModel()
+    {
+        if (!m_HasData || m_IsLoaded)
+            return;
+
+        BindModelVAO();
+        m_IsLoaded = true;
+
+        // paged models read their vertices back from the page file
+        if (this->m_Pages.IsOpen())
+        {
+            HeatMapWorker::GetInstance().CancelJobsOf(this);
+            std::lock_guard<std::mutex> t_Lock(m_StreamMutex);
+            VertexBufferType().swap(m_ObjMesh->vertexBuffer);
+            PositionBufferType().swap(m_ObjMesh->positionBuffer);
+            PositionBufferType().swap(m_ObjMesh->normalBuffer);
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool Model::LoadModelData()
+
+    \brief
+        CPU half of loading: buffers, AABB tree and triangle records. No GL
+        calls are made, so models may be loaded concurrently. A .msb cache 
+        next to the source file is preferred; it already holds the 
+        optimised buffers, bounds and AABB tree, so Assimp and the tree 
+        build are skipped. If a .msp page file sits next to it as well, 
+        the triangle records are not built and the per-node index lists
+        are dropped; queries then page them in (see MeshPages.h).
+    */
+    /*************************************************************************/
+    bool Model::LoadModelData()
     {
 
 		std::cout << "Loading asset :" << this->m_FileName << std::endl;
+		if (this->m_ObjMesh)
+			delete m_ObjMesh;
+
+		this->m_ObjMesh = new Mesh();
+#pragma omp critical(mapDebugMesh)
+        mapDebugMesh[m_FileName] = this->m_ObjMesh;
+
+        if (ReadMeshBinary(this->m_FileName + MESH_BINARY_EXT, this->m_FileName, 
+                           *this->m_ObjMesh, this->m_hAABB, this->m_ModelAABB, this->m_ModelBS))
+        {
+            this->m_ObjMesh->UpdateCPUStreams();
+            // a page file that splits a leaf across pages is not used
+            TriangleRecords::AssignLeafRanges(this->m_hAABB);
+            if (this->m_Pages.Open(this->m_FileName + MESH_PAGES_EXT) &&
+                this->m_Pages.GetVertexCount() == this->m_ObjMesh->vertexBuffer.size() &&
+                this->m_Pages.GetNodeCount() == this->m_hAABB.nodes.size() &&
+                this->m_Pages.HoldsWholeLeaves(this->m_hAABB))
+            {
+                for (u32 i = 0; i < this->m_hAABB.nodes.size(); ++i)
+                {
+                    std::vector<int>().swap(this->m_hAABB.nodes[i].indices);
+                    std::vector<std::array<int, 3> >().swap(this->m_hAABB.nodes[i].triangleIndices);
+                }
+            }
+            else
+            {
+                this->m_Pages.Close();
+                this->m_Triangles.Build(m_ObjMesh->positionBuffer, this->m_hAABB);
+            }
+            this->m_ObjMesh->enMT = MTComplex;
+            this->m_HasCachedBounds = true;
+
+            return true;
+        }
+
+        // OBJ/PLY/STL are read natively, anything else goes through Assimp
+        if (!ReadMeshNative(this->m_FileName, *this->m_ObjMesh) && !LoadAssimpModel())
+            return false;
+
+        // reorder for locality before anything is derived from the buffers
+        OptimizeMesh(*this->m_ObjMesh);
+
+		BuildHierachicalAABB();
+
+#if MESH_BUILD_LODS
+        BuildMeshLODs(*this->m_ObjMesh);
+#endif
+
+        this->m_ObjMesh->enMT = MTComplex;
+
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool Model::LoadAssimpModel()
+
+    \brief
+        Imports m_FileName through Assimp into m_ObjMesh.
+    */
+    /*************************************************************************/
+    bool Model::LoadAssimpModel()
+    {
         Assimp::Importer t_ModelImporter;
         
         const aiScene * t_Scene = t_ModelImporter.ReadFile(this->m_FileName, 
-                                                           aiProcess_CalcTangentSpace         | 
                                                            aiProcess_Triangulate              |
                                                            aiProcess_JoinIdenticalVertices    |
                                                            aiProcess_SortByPType);
-		if (this->m_ObjMesh)
-			delete m_ObjMesh;
-
-		this->m_ObjMesh = new Mesh();
-        mapDebugMesh[m_FileName] = this->m_ObjMesh;
 
         // if unable to create scene ptr obj
         if(!t_Scene)
@@ -145,9 +273,44 @@ namespace Proto
         // ==========================
         // load all the obj data
         // ==========================
-        
-        // store mesh object for future accessing
-        aiMesh * t_Mesh = (*(t_Scene->mMeshes));
+
+        // every triangle part is appended to the one shared buffer with its 
+        // own draw range; the point and line parts split off by 
+        // aiProcess_SortByPType are skipped
+        for(u32 i = 0; i < t_Scene->mNumMeshes; ++i)
+        {
+            if(t_Scene->mMeshes[i]->mPrimitiveTypes == aiPrimitiveType_TRIANGLE)
+                LoadMeshPart(t_Scene->mMeshes[i]);
+        }
+        if(m_ObjMesh->parts.empty())
+            return false;
+
+        // tangent frames over the whole shared buffer in one pass, instead
+        // of aiProcess_CalcTangentSpace serially per aiMesh
+        ComputeTangentSpace(*this->m_ObjMesh, false, true);
+
+        // one draw range per material
+        GroupPartsByMaterial(*this->m_ObjMesh);
+
+        return true;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void Model::LoadMeshPart(const aiMesh * t_Mesh)
+
+    \brief
+        Appends one aiMesh to m_ObjMesh and records its draw range.
+
+    \param t_Mesh
+        This is the mesh object.
+    */
+    /*************************************************************************/
+    void Model::LoadMeshPart(const aiMesh * t_Mesh)
+    {
+        MeshPart t_Part;
+        t_Part.indexStart = m_ObjMesh->indexBuffer.size();
+        t_Part.materialIndex = t_Mesh->mMaterialIndex;
 
         if(t_Mesh->HasPositions())  // load vertices
         {
@@ -170,17 +333,6 @@ namespace Proto
             s+=" no Normals found";
             //GE_WARNING_MSG(s.c_str());
             
-        }
-        if(t_Mesh->HasTangentsAndBitangents())
-        {
-            LoadTangent(t_Mesh);
-        }
-        else
-        {
-            str s=this->m_FileName;
-            s+=" no Tangent and Bitangent found";
-            //GE_WARNING_MSG(s.c_str());
-            
         }
         if(t_Mesh->HasFaces())      // load indices
         {
@@ -205,15 +357,10 @@ namespace Proto
             
         }
 
-
-        BindModelVAO();
-
-
-		BuildHierachicalAABB();
-
-        this->m_ObjMesh->enMT = MTComplex;
-
-        return this->m_IsLoaded = true;
+        t_Part.indexCount = m_ObjMesh->indexBuffer.size() - t_Part.indexStart;
+        m_ObjMesh->numIndices = m_ObjMesh->indexBuffer.size();
+        if(t_Part.indexCount)
+            m_ObjMesh->parts.push_back(t_Part);
     }
 
     /*************************************************************************/
@@ -231,8 +378,8 @@ namespace Proto
     {
         //this->m_ModelBS.m_BVMesh = t_BSModelMesh;
         this->m_ModelBS.RitterSphere(this->m_ModelBS, 
-			this->m_ObjMesh->vertexBuffer,
-			this->m_ObjMesh->vertexBuffer.size());
+			this->m_ObjMesh->positionBuffer,
+			this->m_ObjMesh->positionBuffer.size());
     }
 
     /*************************************************************************/
@@ -249,14 +396,91 @@ namespace Proto
     void Model::BuildAABB(Mesh & t_AABBModelMesh)
     {
         //this->m_ModelAABB.m_BVMesh = t_AABBModelMesh;
-		this->m_ModelAABB.Create(this->m_ObjMesh->vertexBuffer);
+		this->m_ModelAABB.Create(this->m_ObjMesh->positionBuffer);
     }
 
 
 
 	void Model::BuildHierachicalAABB()
 	{
-		this->m_hAABB.BuildFromModel(m_ObjMesh->vertexBuffer, m_ObjMesh->indexBuffer, 7);
+		this->m_hAABB.BuildFromModel(m_ObjMesh->positionBuffer, m_ObjMesh->indexBuffer, 7);
+		this->m_hAABB.ReleaseBuildScratch();
+		this->m_Triangles.Build(m_ObjMesh->positionBuffer, this->m_hAABB);
+	}
+
+    /*************************************************************************/
+    /*!
+    \fn bool Model::SaveBinary(const str & t_FileName)
+
+    \brief
+        Writes the loaded mesh, its bounds and its AABB tree as a .msb cache.
+        BuildSphere and BuildAABB must have been called first. Only the CPU
+        side is needed, the model does not have to be bound.
+    */
+    /*************************************************************************/
+	bool Model::SaveBinary(const str & t_FileName)
+	{
+		if (!this->m_HasData || this->m_Pages.IsOpen())
+			return false;
+		return WriteMeshBinary(t_FileName, m_FileName, *m_ObjMesh, m_hAABB, m_ModelAABB, m_ModelBS);
+	}
+
+    /*************************************************************************/
+    /*!
+    \fn bool Model::SavePages(const str & t_FileName)
+
+    \brief
+        Writes the triangle records and vertices of the loaded mesh as a 
+        .msp page file, for loading the model out-of-core from its cache.
+    */
+    /*************************************************************************/
+	bool Model::SavePages(const str & t_FileName)
+	{
+		if (!this->m_HasData || this->m_Pages.IsOpen())
+			return false;
+		return WriteMeshPages(t_FileName, *m_ObjMesh, m_hAABB, m_Triangles);
+	}
+
+	bool Model::HasCachedBounds() const
+	{
+		return this->m_HasCachedBounds;
+	}
+
+	bool Model::HasData() const
+	{
+		return this->m_HasData;
+	}
+
+	u32 Model::GetVertexCount() const
+	{
+		return this->m_Pages.IsOpen() ? this->m_Pages.GetVertexCount() : this->m_ObjMesh->positionBuffer.size();
+	}
+
+	MeshPageFile * Model::GetMeshPages()
+	{
+		return this->m_Pages.IsOpen() ? &this->m_Pages : nullptr;
+	}
+
+	std::mutex & Model::GetStreamMutex()
+	{
+		return this->m_StreamMutex;
+	}
+
+    /*************************************************************************/
+    /*!
+    \fn void Model::UpdateGPUVertexBuffer()
+
+    \brief
+        Re-sends the vertex buffer after it was edited and refreshes the
+        CPU streams. Heatmap jobs reading this model are stopped first and
+        computed again from the new streams.
+    */
+    /*************************************************************************/
+	void Model::UpdateGPUVertexBuffer()
+	{
+		HeatMapWorker::GetInstance().CancelJobsOf(this);
+		std::lock_guard<std::mutex> t_Lock(m_StreamMutex);
+		this->m_ObjMesh->UpdateGPUVertexBuffer();
 	}
     
     /*************************************************************************/
@@ -328,6 +552,7 @@ namespace Proto
 		glDeleteVertexArrays(1, &m_ObjMesh->VAO);
 		glDeleteBuffers(1, &m_ObjMesh->VBO);
 		glDeleteBuffers(1, &m_ObjMesh->IBO);
+		glDeleteBuffers(1, &m_ObjMesh->HeatMapVBO);
 
 		m_IsLoaded = false;
 		m_FileName.clear();
@@ -364,7 +589,7 @@ namespace Proto
 			m_ObjMesh->vertexBuffer.push_back(v);
         }
             
-		m_ObjMesh->numVertices = t_Size;
+		m_ObjMesh->numVertices += t_Size;
     }
     
     /*************************************************************************/
@@ -380,7 +605,8 @@ namespace Proto
     /*************************************************************************/
     void Model::LoadNormal(const aiMesh * t_Mesh)
     {
-		u32 t_Size = m_ObjMesh->numVertices;
+		u32 t_Size = t_Mesh->mNumVertices;
+		u32 t_Base = m_ObjMesh->numVertices - t_Size; // first vertex of this part
         for(u32 i = 0; i < t_Size;++i)
         {
             aiVector3D t_Normal = t_Mesh->mNormals[i];
@@ -390,40 +616,7 @@ namespace Proto
             v.nrm.y = t_Normal.y;
             v.nrm.z = t_Normal.z;
             
-			m_ObjMesh->vertexBuffer[i].nrm = v.nrm;
-        }
-    }
-    
-    /*************************************************************************/
-    /*!
-    \fn void Model::LoadTangent(const aiMesh * t_Mesh)
-
-    \brief
-        This function loads the tangent and bitangent values of the model object.
-
-    \param t_Mesh
-        This is the mesh object.
-    */
-    /*************************************************************************/
-    void Model::LoadTangent(const aiMesh * t_Mesh)
-    {
-		u32 t_Size = m_ObjMesh->numVertices;
-        for(u32 i = 0; i < t_Size; ++i)
-        {
-            Vertex v;
-
-            aiVector3D t_Tan = t_Mesh->mTangents[i];
-            v.tan.x = t_Tan.x;
-            v.tan.y = t_Tan.y;
-            v.tan.z = t_Tan.z;
-
-            aiVector3D t_Bitan = t_Mesh->mBitangents[i];
-            v.bitan.x = t_Bitan.x;
-            v.bitan.y = t_Bitan.y;
-            v.bitan.z = t_Bitan.z;
-            
-			m_ObjMesh->vertexBuffer[i].tan = v.tan;
-			m_ObjMesh->vertexBuffer[i].bitan = v.bitan;
+			m_ObjMesh->vertexBuffer[t_Base + i].nrm = v.nrm;
         }
     }
     
@@ -440,7 +633,8 @@ namespace Proto
     /*************************************************************************/
     void Model::LoadTextureUV(const aiMesh * t_Mesh)
     {
-		u32 t_Size = m_ObjMesh->numVertices;
+		u32 t_Size = t_Mesh->mNumVertices;
+		u32 t_Base = m_ObjMesh->numVertices - t_Size; // first vertex of this part
         for(u32 i = 0; i < t_Size; ++i)
         {
             //int num = t_Mesh->GetNumUVChannels();
@@ -450,7 +644,7 @@ namespace Proto
             v.uv.x = t_Tex.x;
             v.uv.y = t_Tex.y;
 
-			m_ObjMesh->vertexBuffer[i].uv = v.uv;
+			m_ObjMesh->vertexBuffer[t_Base + i].uv = v.uv;
         }
     }
 
@@ -467,9 +661,9 @@ namespace Proto
     /*************************************************************************/
     void Model::LoadIndices(const aiMesh * t_Mesh)
     {
-        m_ObjMesh->numTris      = t_Mesh->mNumFaces;
-		m_ObjMesh->numIndices = 0;
-		u32 t_TotalTri = m_ObjMesh->numTris;
+		u32 t_TotalTri = t_Mesh->mNumFaces;
+		u32 t_Base = m_ObjMesh->numVertices - t_Mesh->mNumVertices; // first vertex of this part
+        m_ObjMesh->numTris      += t_TotalTri;
 
         for(u32 i = 0; i < t_TotalTri; ++i)
         {
@@ -478,7 +672,7 @@ namespace Proto
 		  m_ObjMesh->numIndices += t_NoOfIndices;
 
           for(int j = 0; j < t_NoOfIndices; ++j)
-			  m_ObjMesh->indexBuffer.push_back(t_Face.mIndices[j]);
+			  m_ObjMesh->indexBuffer.push_back(t_Base + t_Face.mIndices[j]);
         }
 
     }
@@ -531,5 +725,11 @@ namespace Proto
 	}
 
 
+	const TriangleRecords &  Model::GetTriangleRecords()
+	{
+		return this->m_Triangles;
+	}
+
+
 
 }
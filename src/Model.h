@@ -11,6 +11,7 @@
 // includes
 // ==========================
 
+#include <mutex>
 #include "Assimp/aiscene.h"        // Output data structure
 
 #include "BS.h"
@@ -19,6 +20,8 @@
 
 #include "HierachicalBS.h"
 #include "HierachicalAABB.h"
+#include "TriangleRecords.h"
+#include "MeshPages.h"
 #include "SceneObject.h"
 
 // ==========================
@@ -31,7 +34,7 @@ namespace Proto
     {
         public:
             
-            Model	(const str & t_FileName);
+            Model	(const str & t_FileName, bool t_BindNow = true);
             Model	(Mesh & t_Mesh);
             ~Model	();
 
@@ -41,11 +44,14 @@ namespace Proto
             const GLuint &  GetModelTexture();
             const str &     GetModelTextureStringID();
 			bool			LoadModel();
+			bool			LoadModelData();
+			void			BindModel();
             const BS &      GetBS();
             const AABB &    GetAABB();
 		
 			const HierachicalAABB &     GetHierachicalAABB();
 			const HierachicalBS &     GetHierachicalBS();
+			const TriangleRecords &   GetTriangleRecords();
 
 
             void            BuildSphere(Mesh & t_ModelMesh);
@@ -53,11 +59,22 @@ namespace Proto
             void            BuildHierachicalOBB();
 			void			BuildHierachicalAABB();
 			void			UpdateGPUVertexBuffer();
+			bool			SaveBinary(const str & t_FileName);
+			bool			SavePages(const str & t_FileName);
+			bool			HasCachedBounds() const;
+			bool			HasData() const;
+			u32				GetVertexCount() const;
+			MeshPageFile *	GetMeshPages();
+
+			// held while the CPU streams are read off the GL thread, and
+			// by the GL thread while it changes them
+			std::mutex &	GetStreamMutex();
         private:
 
+			bool            LoadAssimpModel();
+			void            LoadMeshPart(const aiMesh * t_Mesh);
 			void            LoadVertices(const aiMesh * t_Mesh);
 			void            LoadNormal(const aiMesh * t_Mesh);
-			void            LoadTangent(const aiMesh * t_Mesh);
 			void            LoadTextureUV(const aiMesh * t_Mesh);
 			void            LoadIndices(const aiMesh * t_Mesh);
 			void            BindModelVAO();
@@ -65,6 +82,8 @@ namespace Proto
 
             str             m_FileName;
             bool            m_IsLoaded;
+            bool            m_HasCachedBounds; // BS/AABB/tree came from the .msb cache
+            bool            m_HasData;   // CPU side loaded, m_IsLoaded once bound
 
 
             Mesh*            m_ObjMesh;   // model mesh
@@ -73,6 +92,9 @@ namespace Proto
 
 			HierachicalBS m_hBS;
 			HierachicalAABB m_hAABB;
+			TriangleRecords m_Triangles; // leaf triangles of m_hAABB
+			MeshPageFile	m_Pages;     // open when the query data is paged from disk
+			std::mutex		m_StreamMutex;
 
 
     };
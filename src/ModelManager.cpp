@@ -5,8 +5,11 @@
     - End Header -------------------------------------------------------*/
 
 #include <fstream>
+#include <cstdio>
+#include <algorithm>
 
 #include "ModelManager.h"
+#include "MeshBinary.h"
 
 
 namespace Proto
@@ -29,6 +32,15 @@ namespace Proto
     }
 
 
+    static u64 GetFileSize(const str & t_FileName)
+    {
+        std::ifstream t_File(t_FileName.c_str(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+        if (!t_File.is_open())
+            return 0;
+        return static_cast<u64>(t_File.tellg());
+    }
+
+
     ModelManager ModelManager::s_Instance = ModelManager();
 
     /*************************************************************************/
@@ -78,6 +90,8 @@ namespace Proto
 
     \brief
         This function loads all the model objects required for the game.
+        Files are read and their bounding volumes built on the OpenMP pool,
+        largest file first, then every model is bound on this (GL) thread.
     
     \param t_FileName
         This is the file name of the model object.
@@ -95,33 +109,126 @@ namespace Proto
             return false;
 
         u32 t_Size = t_FileCont.size();
+        STRCONT t_IDs(t_Size), t_ModelFileNames(t_Size);
+        std::vector<std::pair<u64, u32> > t_Order(t_Size);
         for(u32 i = 0; i < t_Size; ++i)
         {
             str    t_Line           = t_FileCont[i];
             size_t t_DelimiterPos   = t_Line.find_first_of(" ");
-            str    t_ID             = t_Line.substr(0, t_DelimiterPos);
-            str    t_ModelFileName  = t_Line.substr(t_DelimiterPos + 1);
+            t_IDs[i]                = t_Line.substr(0, t_DelimiterPos);
+            t_ModelFileNames[i]     = t_Line.substr(t_DelimiterPos + 1);
+            t_Order[i]              = std::make_pair(GetFileSize(t_ModelFileNames[i]), i);
+        }
+        // longest jobs first so the pool drains evenly
+        std::sort(t_Order.rbegin(), t_Order.rend());
 
-            Model * t_Model = new Model(t_ModelFileName);
-            this->m_ModelContainer.insert(MODELINFO(t_ID.c_str(), t_Model));
+        // CPU phase, no GL calls
+        std::vector<Model *> t_Models(t_Size, nullptr);
+#pragma omp parallel for schedule(dynamic, 1)
+        for(s32 j = 0; j < static_cast<s32>(t_Size); ++j)
+        {
+            u32 i = t_Order[j].second;
+            t_Models[i] = new Model(t_ModelFileNames[i], false);
+        }
 
-            if(t_ID.compare("MODEL_DSPHERE") != 0 && t_ID.compare("MODEL_DCUBE")  != 0 && t_Model)
-            {
+        for(u32 i = 0; i < t_Size; ++i)
+            this->m_ModelContainer.insert(MODELINFO(t_IDs[i].c_str(), t_Models[i]));
+
+        Mesh & t_DSphereMesh = this->m_ModelContainer["MODEL_DSPHERE"]->GetModelMesh();
+        Mesh & t_DCubeMesh = this->m_ModelContainer["MODEL_DCUBE"]->GetModelMesh();
 
-				t_Model->BuildSphere(this->m_ModelContainer["MODEL_DSPHERE"]->GetModelMesh());
-	            t_Model->BuildAABB(this->m_ModelContainer["MODEL_DCUBE"]->GetModelMesh());
+        // the tree is built in LoadModel, the cache also carries the bounds
+#pragma omp parallel for schedule(dynamic, 1)
+        for(s32 i = 0; i < static_cast<s32>(t_Size); ++i)
+        {
+            Model * t_Model = t_Models[i];
+            if(t_IDs[i].compare("MODEL_DSPHERE") != 0 && t_IDs[i].compare("MODEL_DCUBE")  != 0 && t_Model->HasData() && !t_Model->HasCachedBounds())
+            {
+				t_Model->BuildSphere(t_DSphereMesh);
+	            t_Model->BuildAABB(t_DCubeMesh);
 				//t_Model->BuildHierachicalOBB();
-				t_Model->BuildHierachicalAABB();
             }
-            
         }
 
+        // GL phase
+        for(u32 i = 0; i < t_Size; ++i)
+            t_Models[i]->BindModel();
+
         t_FileCont.clear();
         std::cout << "Models loaded successfully." << std::endl;
         return true;
     }
 
 
+    /*************************************************************************/
+    /*!
+    \fn bool ModelManager::ConvertAllModels(const str & t_FileName)
+
+    \brief
+        Loads every model listed in the file from its source and writes its 
+        .msb cache next to it, plus a .msp page file for models of at least
+        MESH_PAGE_MIN_TRIANGLES triangles. Existing caches are discarded 
+        first so the source is always re-imported.
+    
+    \param t_FileName
+        This is the model list, in the same format as LoadAllModels.
+
+    \return
+        This function returns TRUE if every model was converted.
+    */
+    /*************************************************************************/
+    bool ModelManager::ConvertAllModels(const str & t_FileName)
+    {
+        STRCONT t_FileCont;
+        
+        if(!LoadConfigurationFrom(t_FileName.c_str(), t_FileCont))
+            return false;
+
+        // the bounds are built with the same calls as LoadAllModels; the
+        // debug models are not loaded yet when converting from main
+        Mesh t_DSphereMesh, t_DCubeMesh;
+        MODEL_ITER t_DSphere = this->m_ModelContainer.find("MODEL_DSPHERE");
+        MODEL_ITER t_DCube = this->m_ModelContainer.find("MODEL_DCUBE");
+        Mesh & t_BSMesh = (t_DSphere != this->m_ModelContainer.end() && t_DSphere->second) ?
+                          t_DSphere->second->GetModelMesh() : (t_DSphereMesh = CreateSphere(8, 8));
+        Mesh & t_AABBMesh = (t_DCube != this->m_ModelContainer.end() && t_DCube->second) ?
+                            t_DCube->second->GetModelMesh() : (t_DCubeMesh = CreateCube(1, 1, 1));
+
+        bool t_Result = true;
+        u32 t_Size = t_FileCont.size();
+        for(u32 i = 0; i < t_Size; ++i)
+        {
+            str    t_Line           = t_FileCont[i];
+            size_t t_DelimiterPos   = t_Line.find_first_of(" ");
+            str    t_ModelFileName  = t_Line.substr(t_DelimiterPos + 1);
+            str    t_CacheFileName  = t_ModelFileName + MESH_BINARY_EXT;
+            str    t_PagesFileName  = t_ModelFileName + MESH_PAGES_EXT;
+
+            std::remove(t_CacheFileName.c_str());
+            std::remove(t_PagesFileName.c_str());
+
+            // only the CPU side is written, the model is never bound
+            Model t_Model(t_ModelFileName, false);
+            bool t_Saved = false;
+            if (t_Model.HasData())
+            {
+                t_Model.BuildSphere(t_BSMesh);
+                t_Model.BuildAABB(t_AABBMesh);
+                t_Saved = t_Model.SaveBinary(t_CacheFileName);
+#if MESH_PAGE_MIN_TRIANGLES
+                // scans this large are loaded out-of-core from now on
+                if (t_Saved && t_Model.GetModelMesh().indexBuffer.size() / 3 >= MESH_PAGE_MIN_TRIANGLES)
+                    t_Saved = t_Model.SavePages(t_PagesFileName);
+#endif
+            }
+            std::cout << (t_Saved ? "Converted " : "Unable to convert ") << t_ModelFileName << std::endl;
+            t_Result = t_Result && t_Saved;
+        }
+
+        return t_Result;
+    }
+
+
 	void ModelManager::AddModel(const str & t_ModelID, Model* t_Model)
 	{
 		this->m_ModelContainer.insert(MODELINFO(t_ModelID.c_str(), t_Model));
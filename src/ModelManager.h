@@ -34,6 +34,7 @@ namespace Proto
 			MODEL_CONT &        GetModelContainer();
             MODEL_CONT &        GetAtbModelContainer();
             bool                LoadAllModels(const str & t_FileName);
+            bool                ConvertAllModels(const str & t_FileName);
 			void                AddModel(const str & t_ModelID, Model* t_Model);
             void                UnloadAllModels();
             Model *             GetModel(const str & t_ModelID);
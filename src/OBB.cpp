@@ -66,7 +66,7 @@
 	// method build_from_covariance_matrix() method to fit 
 	// the box.  ALL points will be fit in the box, regardless
 	// of whether they are indexed by a triangle or not.
-	void OBB::BuildFromModel(const VertexBufferType &pnts, const std::vector<int> &indicies){
+	void OBB::BuildFromModel(const PositionBufferType &pnts, const std::vector<int> &indicies){
 
 		f32 Ai, Am = 0.0;
 		vec3 mu(0.0f, 0.0f, 0.0f), bc;
@@ -77,9 +77,9 @@
 		// mean location
 		int totalTris = indicies.size();
 		for (int i = 0; i<totalTris; i += 3){
-			const Vec3 &p = pnts[indicies[i	 ]].pos;		
-			const Vec3 &q = pnts[indicies[i + 1]].pos;
-			const Vec3 &r = pnts[indicies[i + 2]].pos;//get vertex of triangles
+			const Vec3 &p = pnts[indicies[i	 ]];		
+			const Vec3 &q = pnts[indicies[i + 1]];
+			const Vec3 &r = pnts[indicies[i + 2]];//get vertex of triangles
 			bc = (p + q + r) / 3.0f; //baricenter of the points p + q + r
 			vec3 dir = glm::cross((q - p), (r - p));
 			Ai = glm::length(dir) * 0.5f; // area of the triangle
@@ -128,7 +128,7 @@
 	// above.  
 
 
-	void OBB::CovarianceMatrix(mat3 &C, const VertexBufferType &pnts, const std::vector<int> &indicies){
+	void OBB::CovarianceMatrix(mat3 &C, const PositionBufferType &pnts, const std::vector<int> &indicies){
 		// extract the eigenvalues and eigenvectors from C
 		mat3 eigvec;
 		std::vector<f32> eigval(3);
@@ -189,7 +189,7 @@
 		u32 total = indicies.size();
 		for (u32 i = 0; i<total; i++){
 			u32 index = indicies[i];
-			Vec3 p_prime(Dot(r, pnts[index].pos), Dot(u, pnts[index].pos), Dot(f, pnts[index].pos));
+			Vec3 p_prime(Dot(r, pnts[index]), Dot(u, pnts[index]), Dot(f, pnts[index]));
 			minim.x = std::min(p_prime.x, minim.x);
 			minim.y = std::min(p_prime.y, minim.y);
 			minim.z = std::min(p_prime.z, minim.z);
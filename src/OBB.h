@@ -40,7 +40,7 @@ Creation Date:  10/10/2014
 		mat4& GetBoxTransform(mat4& output);
 
 
-		void BuildFromModel(const VertexBufferType &pnts, const std::vector<int> &indicies);
+		void BuildFromModel(const PositionBufferType &pnts, const std::vector<int> &indicies);
 
 
 		vec3 m_center;
@@ -51,7 +51,7 @@ Creation Date:  10/10/2014
 
 
 	private:
-		void CovarianceMatrix(mat3 &C, const VertexBufferType &pnts, const std::vector<int> &indicies);
+		void CovarianceMatrix(mat3 &C, const PositionBufferType &pnts, const std::vector<int> &indicies);
 	
 	};
 
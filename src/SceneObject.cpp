@@ -11,7 +11,9 @@ namespace Proto
         m_AlphaVal(1.f),
         m_ScaleVec(vec3(1.f, 1.f, 1.f)),
         m_RotVec(vec3(0.f, 0.f, 0.f)),
-		m_IsDirty(true)
+		m_IsDirty(true),
+		m_TransformVersion(0),
+		m_IsInView(true)
 
     {
         this->m_MeshRenderer = new GFXComponent();
@@ -35,6 +37,8 @@ namespace Proto
 		m_ScaleVec = r.m_ScaleVec;
 		m_RotVec = r.m_RotVec;
 		m_IsDirty = r.m_IsDirty;
+		m_TransformVersion = r.m_TransformVersion;
+		m_IsInView = r.m_IsInView;
 		this->m_MeshRenderer = new GFXComponent(*r.m_MeshRenderer);
 	}
 
@@ -78,12 +82,12 @@ namespace Proto
 
     void SceneObject::SetPosVec(const vec3 & t_PosVec)
     {
+		m_IsDirty = true;
         this->m_PosVec = t_PosVec;
     }
 
     const vec3 & SceneObject::GetPosVec()
     {
-		m_IsDirty = true;
         return this->m_PosVec;
     }
 
@@ -102,6 +106,7 @@ namespace Proto
 		if (m_IsDirty)
 		{
 			m_IsDirty = false;
+			++m_TransformVersion;
 			this->m_MeshRenderer->Update(this->m_MWMatrix,
 				this->m_PosVec,
 				this->m_RotVec,
@@ -113,12 +118,6 @@ namespace Proto
 
 
 
-    void SceneObject::Draw(const mat4& viewMatrix, bool wireframe)
-    {
-        mat4 MVMat, normalMVMat; 
-        this->m_MeshRenderer->Draw(viewMatrix, this->m_MWMatrix,  wireframe);
-    }
-
 	void SceneObject::DrawDebugSphere(const mat4& viewMatrix)
 	{
 		mat4 MVMat, normalMVMat; 
@@ -131,13 +130,12 @@ namespace Proto
 		this->m_MeshRenderer->DrawDebugAABB(viewMatrix);
 	}
 
-    void SceneObject::DrawDebugHierachicalAABB(const mat4& viewMatrix)
+    void SceneObject::CollectDebugHierachicalAABB(const Frustum& frustum, std::vector<InstanceData>& boxes)
     {
-        //if (this->m_IsInView == CS350::OUTSIDE)
-        //    return;
+        if (!this->m_IsInView)
+            return;
 
-        mat4 MVMat, normalMVMat;
-        this->m_MeshRenderer->DrawDebugHierachicalAABB(viewMatrix);
+        this->m_MeshRenderer->CollectDebugHierachicalAABB(frustum, boxes);
     }
 	
 
@@ -206,4 +204,19 @@ namespace Proto
 		return m_IsDirty;
 	}
 
+	u32 SceneObject::GetTransformVersion() const
+	{
+		return m_TransformVersion;
+	}
+
+	bool SceneObject::IsInView() const
+	{
+		return m_IsInView;
+	}
+
+	void SceneObject::SetInView(bool t_IsInView)
+	{
+		m_IsInView = t_IsInView;
+	}
+
 };
\ No newline at end of file
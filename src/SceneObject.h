@@ -7,6 +7,7 @@
 
 #include "defines.h"
 #include "IControlledSceneObject.h"
+#include "Frustum.h"
 #include "GFXComponent.h"
 /* Start Header ------------------------------------------------------
 
@@ -43,11 +44,10 @@ namespace Proto
 		virtual ~SceneObject();
 		SceneObject(const SceneObject& rhs);
 		//virtual void        Update(const double & t_DeltaTime) = 0;
-        virtual void        Draw(const mat4& viewMatrix, bool wireframe = false);
 		virtual void        DrawDebugSphere(const mat4& viewMatrix);
 		virtual void        DrawDebugAABB(const mat4& viewMatrix);
 
-		virtual void		DrawDebugHierachicalAABB(const mat4& viewMatrix);
+		virtual void		CollectDebugHierachicalAABB(const Frustum& frustum, std::vector<InstanceData>& boxes);
 
 		const str &         GetSoInstID() const;
 		void                SetSoInstID(const str & t_GoInstID);
@@ -80,6 +80,13 @@ namespace Proto
 
 		virtual bool isMoved();
 
+		// bumped every time Update recomputes the world transform
+		u32                 GetTransformVersion() const;
+
+		// set by SceneObjectManager::DrawAll from the camera frustum
+		bool                IsInView() const;
+		void                SetInView(bool t_IsInView);
+
 		// init and deinit GOInst info
 		//virtual void        Init(void);
 		//void                Init(SceneObject* t_inst);
@@ -92,6 +99,8 @@ namespace Proto
 		static GOINST_VEC   s_SceneObjects;
 		bool                m_IsAlive;
 		bool                m_IsDirty;
+		u32                 m_TransformVersion;
+		bool                m_IsInView;
 		f32                 m_AlphaVal;
         GFXComponent*       m_MeshRenderer;
 		str                 m_SOClassType;
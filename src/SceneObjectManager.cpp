@@ -8,6 +8,7 @@ Creation Date:  24/Sep/2016
 #include "SceneObjectManager.h"
 #include "graphics.hpp"
 #include <algorithm>
+#include <chrono>
 #include "Collision.h"
 namespace Proto
 {
@@ -39,7 +40,14 @@ namespace Proto
 	SceneObjectManager::SceneObjectManager()
 		: renderObjectCount(9)
 		, currentRadiusUnitCount(8)
-
+		, m_Broadphase(&m_SweepAndPrune)
+		, m_BroadphaseType(BroadphaseType::SWEEP_AND_PRUNE)
+		, m_BroadphaseMs(0.f)
+		, m_BroadphasePairCount(0)
+		, m_DebugBoxModel(nullptr)
+		, m_DebugBoxVBO(0)
+		, m_DebugBoxCapacity(0)
+		, m_DebugBoxDrawCount(0)
 	{
 
 
@@ -61,7 +69,7 @@ namespace Proto
 
 	size_t	SceneObjectManager::GetNumberofSceneObjects()
 	{
-		return m_AllActiveObj.size();
+		return m_Objects.size();
 	}
 
 	/*************************************************************************/
@@ -81,113 +89,322 @@ namespace Proto
 	/*************************************************************************/
 	void SceneObjectManager::UpdateAll(const f32 & t_DeltaTime)
 	{
-
-		UpdateObj<GOINST_CONT, SceneObject>(this->m_AllActiveObj, t_DeltaTime);
+        u32 t_Count = m_Objects.size();
 
         if (boRotateModels)
         {
-            
-            for (int i = 0; i < m_RenderList.size(); ++i)
+            for (u32 i = 0; i < t_Count; ++i)
             {
-                SceneObject* pSO = m_RenderList[i];
+                SceneObject* pSO = m_Objects[i];
                 vec3 rot = pSO->GetRotVec();
                 pSO->SetRotVec(rot + rotVec);
             }
         }
 
-        for (int i = 0; i < m_RenderList.size(); ++i)
+        // every object is updated, only moved ones refresh the packed
+        // transforms and world bounds and the structures built on them
+        for (u32 i = 0; i < t_Count; ++i)
         {
-            GFXComponent& go1(*this->m_RenderList[i]->GetMeshRenderer());
-            for (int j = 0; j < m_RenderList.size(); ++j)
-            {
-                if (i == j)
-                    continue;
-                GFXComponent& go2(*this->m_RenderList[j]->GetMeshRenderer());
+            SceneObject * t_Obj = m_Objects[i];
+            m_Dirty[i] = t_Obj->isMoved();
+            t_Obj->Update(t_DeltaTime);
+
+            // the model, texture and colour can be changed from the tweak bar
+            GFXComponent * t_Renderer = t_Obj->GetMeshRenderer();
+            m_InstanceBatches.Refresh(m_Slots[i], t_Renderer->GetModel(), t_Renderer->GetColorTexture(),
+                                      t_Obj->GetMWMatrix(), t_Renderer->GetDefaultColor());
+            if (!m_Dirty[i])
+                continue;
+
+            m_WorldMatrices[i] = t_Obj->GetMWMatrix();
+            m_WorldAABBs[i] = t_Obj->GetMeshRenderer()->GetWorldSpaceAABB();
+            m_Broadphase->Update(m_Slots[i], m_WorldAABBs[i]);
+            m_SceneGraph.UpdateObject(t_Obj);
+            m_InstanceBatches.Update(m_Slots[i], m_WorldMatrices[i]);
+        }
 
-                hAABBhAABBCollision(go1.GetHAABB(), go2.GetHAABB());
-            }
+        // the flags of every tree are cleared once, so an object marked
+        // against several others keeps all of its marks
+        for (u32 i = 0; i < t_Count; ++i)
+            ClearCollided(m_Objects[i]->GetMeshRenderer()->GetHAABB());
+
+        // only pairs whose world boxes overlap reach the hierarchical test,
+        // each once
+        typedef std::chrono::high_resolution_clock Clock;
+        Clock::time_point t_Start = Clock::now();
+        const BroadphasePairs & t_Pairs = m_Broadphase->FindPairs();
+        m_BroadphaseMs = std::chrono::duration<f32, std::milli>(Clock::now() - t_Start).count();
+        m_BroadphasePairCount = t_Pairs.size();
+        for (u32 i = 0; i < t_Pairs.size(); ++i)
+        {
+            GFXComponent& go1(*this->m_Objects[m_SlotIndices[t_Pairs[i].first]]->GetMeshRenderer());
+            GFXComponent& go2(*this->m_Objects[m_SlotIndices[t_Pairs[i].second]]->GetMeshRenderer());
+
+            MarkCollided(go1.GetHAABB(), go2.GetHAABB());
         }
 	}
 
 	void SceneObjectManager::UpdateRotation(const vec3& rotVec)
 	{
-		auto t_Start = this->m_RenderList.begin();
-		auto t_End = this->m_RenderList.end();
-		for (size_t renderCount = 0; t_Start != t_End && renderCount <renderObjectCount; ++t_Start, ++renderCount)
-			if ((*t_Start))
-			{
-				(*t_Start)->SetRotVec(rotVec);
-			}
+		size_t t_Count = std::min(m_Objects.size(), renderObjectCount);
+		for (size_t i = 0; i < t_Count; ++i)
+			m_Objects[i]->SetRotVec(rotVec);
 	}
 
 	/*************************************************************************/
 	/*!
-	\fn void GameObjMgr::DrawAllObjects(bool t_ShowBV)
+	\fn void SceneObjectManager::DrawAll(const mat4& viewMatrix, 
+	                                     const mat4& projMatrix)
 
 	\brief
-	This function performs drawing to all game objects.
-
-	\param t_ShowBV
-	This is the flag which indicates if bounding volume should be shown.
+	This function draws the objects inside the camera frustum, and their
+	debug boxes when bounding volumes are shown.
 	*/
 	/*************************************************************************/
-	void SceneObjectManager::DrawAll(const mat4& viewMatrix)
+	void SceneObjectManager::DrawAll(const mat4& viewMatrix, const mat4& projMatrix)
 	{
-
-		//<! draw objects
-		auto t_Start = this->m_RenderList.begin();
-		auto t_End = this->m_RenderList.end();
-		vec3 c(255.f, 255.f, 255.f);
-#if 1
-		SendObjectColor(c, objectColorLoc);
-		for (size_t renderCount = 0; t_Start != t_End && renderCount <renderObjectCount; ++t_Start, ++renderCount)
-			if (*t_Start)
-				(*t_Start)->Draw(viewMatrix, drawWireFrame);
-#endif
-
-        if (drawBoundingVolumes)// && useAABBFustrumCulling)
+		Frustum t_Frustum;
+		t_Frustum.Extract(projMatrix * viewMatrix);
+
+		//<! cull through the scene graph, only its survivors are in view
+		for (size_t i = 0; i < m_Objects.size(); ++i)
+			m_Objects[i]->SetInView(false);
+		m_VisibleObjects.clear();
+		m_SceneGraph.CollectInFrustum(t_Frustum, m_VisibleObjects);
+		for (size_t i = 0; i < m_VisibleObjects.size(); ++i)
+			m_VisibleObjects[i]->SetInView(true);
+
+		//<! draw objects, one instanced draw per model and texture as long
+		//<! as the visible instances of the group share a LOD
+		size_t t_Count = std::min(m_Objects.size(), renderObjectCount);
+		m_SlotVisible.assign(m_SlotGenerations.size(), 0);
+		for (size_t i = 0; i < t_Count; ++i)
+			m_SlotVisible[m_Slots[i]] = m_Objects[i]->IsInView();
+		m_InstanceBatches.Upload();
+		m_InstanceBatches.Draw(viewMatrix, drawWireFrame, m_SlotVisible);
+
+        //<! draw debug aabbs of all objects with a single instanced draw
+        m_DebugBoxDrawCount = 0;
+        if (drawBoundingVolumes)
         {
-            //<! draw debug aabbs
-            t_Start = this->m_RenderList.begin();
-
-            for (size_t renderCount = 0; t_Start != t_End && renderCount <renderObjectCount; ++t_Start, ++renderCount)
-            {
-                if ((*t_Start))
-                {
-                    (*t_Start)->DrawDebugHierachicalAABB(viewMatrix);
-                }
-            }
+            m_DebugBoxes.clear();
+            for (size_t i = 0; i < t_Count; ++i)
+                m_Objects[i]->CollectDebugHierachicalAABB(t_Frustum, m_DebugBoxes);
+            DrawDebugBoxes(viewMatrix);
         }
 	}
 
+	/*************************************************************************/
+	/*!
+	\fn void SceneObjectManager::DrawDebugBoxes(const mat4& viewMatrix)
 
-	void   SceneObjectManager::AddSceneObject(SceneObject * t_Inst)
+	\brief
+	Sends the collected debug boxes as this frame's instance stream and draws
+	them all as unit cube lines. The buffer is orphaned each frame and only
+	reallocated when the boxes outgrow it.
+	*/
+	/*************************************************************************/
+	void SceneObjectManager::DrawDebugBoxes(const mat4& viewMatrix)
 	{
-		GOINST_CONT::iterator i = m_AllActiveObj.find(t_Inst->GetSoInstID());
-		if (i != m_AllActiveObj.end())
+		if (m_DebugBoxes.empty())
+			return;
+
+		//names are only resolved once, with the buffer
+		if (!m_DebugBoxVBO)
 		{
-			delete m_AllActiveObj[t_Inst->GetSoInstID()];
-			auto j = std::find(m_RenderList.begin(), m_RenderList.end(), t_Inst);
-			m_RenderList.erase(j);
+			m_DebugBoxModel = ModelManager::GetInstance().GetModel("MODEL_DCUBE");
+			glGenBuffers(1, &m_DebugBoxVBO);
 		}
+		glBindBuffer(GL_ARRAY_BUFFER, m_DebugBoxVBO);
+		if (m_DebugBoxes.size() > m_DebugBoxCapacity)
+			m_DebugBoxCapacity = m_DebugBoxes.capacity();
+		glBufferData(GL_ARRAY_BUFFER, m_DebugBoxCapacity * instanceSize, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_DebugBoxes.size() * instanceSize, &m_DebugBoxes[0]);
+
+		const Mesh & t_BoxMesh = m_DebugBoxModel->GetModelMesh();
+		glUniform1i(instancingOnLoc, true);
+		glUniformMatrix4fv(mainViewMatLoc, 1, GL_FALSE, &viewMatrix[0][0]);
+		BindInstanceStream(t_BoxMesh, m_DebugBoxVBO, 0);
+		RenderMeshObj(t_BoxMesh, true, -1, m_DebugBoxes.size());
+		UnbindInstanceStream(t_BoxMesh);
+		glUniform1i(instancingOnLoc, false);
+		m_DebugBoxDrawCount = 1;
+	}
+
+	/*************************************************************************/
+	/*!
+	\fn SceneObjectHandle SceneObjectManager::AddSceneObject(SceneObject * t_Inst)
 
-		m_RenderList.push_back(t_Inst);
-		m_AllActiveObj[t_Inst->GetSoInstID()] = t_Inst;
+	\brief
+	Appends the object to the packed arrays and hands out a handle to it.
+	An object already registered under the same name is removed first.
+	*/
+	/*************************************************************************/
+	SceneObjectHandle SceneObjectManager::AddSceneObject(SceneObject * t_Inst)
+	{
+		SceneObjectHandle t_Existing = FindSceneObject(t_Inst->GetSoInstID());
+		if (IsValid(t_Existing))
+		{
+			if (GetSceneObject(t_Existing) == t_Inst)
+				return t_Existing;
+			RemoveSceneObject(t_Existing);
+		}
 
+		SceneObjectHandle t_Handle;
+		if (m_FreeSlots.empty())
+		{
+			t_Handle.m_Slot = m_SlotGenerations.size();
+			m_SlotGenerations.push_back(0);
+			m_SlotIndices.push_back(0);
+		}
+		else
+		{
+			t_Handle.m_Slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		t_Handle.m_Generation = m_SlotGenerations[t_Handle.m_Slot];
+		m_SlotIndices[t_Handle.m_Slot] = m_Objects.size();
+
+		m_Objects.push_back(t_Inst);
+		m_Slots.push_back(t_Handle.m_Slot);
+		m_WorldMatrices.push_back(t_Inst->GetMWMatrix());
+		m_WorldAABBs.push_back(t_Inst->GetMeshRenderer()->GetWorldSpaceAABB());
+		m_Dirty.push_back(1);
+		m_NameLookup[t_Inst->GetSoInstID()] = t_Handle;
+		m_Broadphase->Add(t_Handle.m_Slot, m_WorldAABBs.back());
+		m_SceneGraph.InsertObject(t_Inst);
+		GFXComponent * t_Renderer = t_Inst->GetMeshRenderer();
+		m_InstanceBatches.Add(t_Handle.m_Slot, t_Renderer->GetModel(), t_Renderer->GetColorTexture(),
+		                      m_WorldMatrices.back(), t_Renderer->GetDefaultColor());
+
+		return t_Handle;
 	}
-	void  SceneObjectManager::RemoveSceneObject(const str & t_InstName)
+
+	/*************************************************************************/
+	/*!
+	\fn void SceneObjectManager::RemoveSceneObject(SceneObjectHandle t_Handle)
+
+	\brief
+	Deletes the object and moves the last packed entry into its place, so
+	removal is O(1). The slot's generation is bumped, which invalidates
+	every handle still pointing at it.
+	*/
+	/*************************************************************************/
+	void  SceneObjectManager::RemoveSceneObject(SceneObjectHandle t_Handle)
 	{
-		GOINST_CONT::iterator t_Inst = this->m_AllActiveObj.find(t_InstName);
-		GOINST_CONT::iterator t_End = this->m_AllActiveObj.end();
+		if (!IsValid(t_Handle))
+			return;
+
+		u32 t_Index = m_SlotIndices[t_Handle.m_Slot];
+		u32 t_Last = m_Objects.size() - 1;
+		SceneObject * t_Obj = m_Objects[t_Index];
 
-		// return the pointer to the instance if found. o.w., return null.
-		if ((t_Inst != t_End))
+		m_NameLookup.erase(t_Obj->GetSoInstID());
+		m_Broadphase->Remove(t_Handle.m_Slot);
+		m_SceneGraph.RemoveObject(t_Obj);
+		m_InstanceBatches.Remove(t_Handle.m_Slot);
+		++m_SlotGenerations[t_Handle.m_Slot];
+		m_FreeSlots.push_back(t_Handle.m_Slot);
+
+		if (t_Index != t_Last)
 		{
-			delete t_Inst->second;
-			m_AllActiveObj.erase(t_Inst);
-			auto j = std::find(m_RenderList.begin(), m_RenderList.end(), t_Inst->second);
-			m_RenderList.erase(j);
+			m_Objects[t_Index]          = m_Objects[t_Last];
+			m_Slots[t_Index]            = m_Slots[t_Last];
+			m_WorldMatrices[t_Index]    = m_WorldMatrices[t_Last];
+			m_WorldAABBs[t_Index]       = m_WorldAABBs[t_Last];
+			m_Dirty[t_Index]            = m_Dirty[t_Last];
+			m_SlotIndices[m_Slots[t_Index]] = t_Index;
 		}
+		m_Objects.pop_back();
+		m_Slots.pop_back();
+		m_WorldMatrices.pop_back();
+		m_WorldAABBs.pop_back();
+		m_Dirty.pop_back();
+
+		delete t_Obj;
+	}
+
+	void  SceneObjectManager::RemoveSceneObject(const str & t_InstName)
+	{
+		RemoveSceneObject(FindSceneObject(t_InstName));
+	}
+
+	SceneObjectHandle SceneObjectManager::FindSceneObject(const str & t_InstName) const
+	{
+		std::unordered_map<str, SceneObjectHandle>::const_iterator t_Iter = m_NameLookup.find(t_InstName);
+		return (t_Iter != m_NameLookup.end()) ? t_Iter->second : SceneObjectHandle();
+	}
+
+	bool SceneObjectManager::IsValid(SceneObjectHandle t_Handle) const
+	{
+		return t_Handle.m_Slot < m_SlotGenerations.size() &&
+			   m_SlotGenerations[t_Handle.m_Slot] == t_Handle.m_Generation;
+	}
+
+	SceneObject * SceneObjectManager::GetSceneObject(SceneObjectHandle t_Handle) const
+	{
+		return IsValid(t_Handle) ? m_Objects[m_SlotIndices[t_Handle.m_Slot]] : nullptr;
+	}
+
+	SceneObject * SceneObjectManager::GetSceneObjectAt(u32 t_Index) const
+	{
+		return m_Objects[t_Index];
+	}
+
+	SceneObjectHandle SceneObjectManager::GetHandleAt(u32 t_Index) const
+	{
+		SceneObjectHandle t_Handle;
+		t_Handle.m_Slot = m_Slots[t_Index];
+		t_Handle.m_Generation = m_SlotGenerations[t_Handle.m_Slot];
+		return t_Handle;
+	}
+
+	const mat4 & SceneObjectManager::GetWorldMatrixAt(u32 t_Index) const
+	{
+		return m_WorldMatrices[t_Index];
+	}
+
+	const AABB & SceneObjectManager::GetWorldAABBAt(u32 t_Index) const
+	{
+		return m_WorldAABBs[t_Index];
+	}
+
+	bool SceneObjectManager::IsDirtyAt(u32 t_Index) const
+	{
+		return m_Dirty[t_Index] != 0;
+	}
+
+	void SceneObjectManager::SetBroadphase(u32 t_Type)
+	{
+		if (t_Type == m_BroadphaseType || t_Type >= BroadphaseType::NUM_BROADPHASES)
+			return;
+
+		m_BroadphaseType = t_Type;
+		m_Broadphase->Clear();
+		m_Broadphase = (t_Type == BroadphaseType::SPATIAL_HASH) ? 
+			static_cast<IBroadphase *>(&m_SpatialHash) : static_cast<IBroadphase *>(&m_SweepAndPrune);
+		for (u32 i = 0; i < m_Objects.size(); ++i)
+			m_Broadphase->Add(m_Slots[i], m_WorldAABBs[i]);
+	}
+
+	f32 SceneObjectManager::GetBroadphaseMs() const
+	{
+		return m_BroadphaseMs;
+	}
+
+	u32 SceneObjectManager::GetBroadphasePairCount() const
+	{
+		return m_BroadphasePairCount;
+	}
+
+	ISceneGraph & SceneObjectManager::GetSceneGraph()
+	{
+		return m_SceneGraph;
+	}
+
+	u32 SceneObjectManager::GetInstancedDrawCount() const
+	{
+		return m_InstanceBatches.GetDrawCount() + m_DebugBoxDrawCount;
 	}
 
 	size_t SceneObjectManager::GetRenderObjCount()
@@ -196,7 +413,7 @@ namespace Proto
 	}
 	void SceneObjectManager::incrementRenderObjCount()
 	{
-		if (renderObjectCount + currentRadiusUnitCount + 8 < m_AllActiveObj.size())
+		if (renderObjectCount + currentRadiusUnitCount + 8 < m_Objects.size())
 		{
 			currentRadiusUnitCount += 8;
 			renderObjectCount += currentRadiusUnitCount;
@@ -14,6 +14,10 @@ Creation Date:  24/Sep/2016
 #include "defines.h"
 #include "SceneObject.h"
 #include "Plane.h"
+#include "SweepAndPrune.h"
+#include "SpatialHash.h"
+#include "BVHSceneGraph.h"
+#include "InstanceBatches.h"
 
 
 
@@ -27,9 +31,6 @@ Creation Date:  24/Sep/2016
 // class/ function prototypes
 // ==========================
 
-typedef std::unordered_map<str, Proto::SceneObject*>           GOINST_CONT;
-typedef GOINST_CONT::iterator                                   m_AllActiveObj;
-
 //typedef std::unordered_map<str, GAM300::TransitionScreen *> ScreenItems;
 
 
@@ -37,6 +38,29 @@ typedef GOINST_CONT::iterator                                   m_AllActiveObj;
 
 namespace Proto
 {
+	// Stable reference to a scene object. The slot is reused once the object
+	// is removed, the generation tells a stale handle apart from its successor.
+	struct SceneObjectHandle
+	{
+		SceneObjectHandle() : m_Slot(~0u), m_Generation(0) {}
+
+		bool operator == (const SceneObjectHandle & t_Other) const
+		{
+			return m_Slot == t_Other.m_Slot && m_Generation == t_Other.m_Generation;
+		}
+		bool operator != (const SceneObjectHandle & t_Other) const
+		{
+			return !(*this == t_Other);
+		}
+		bool operator < (const SceneObjectHandle & t_Other) const
+		{
+			return m_Slot < t_Other.m_Slot || (m_Slot == t_Other.m_Slot && m_Generation < t_Other.m_Generation);
+		}
+
+		u32 m_Slot;
+		u32 m_Generation;
+	};
+
 	class SceneObjectManager
 	{
 	public:
@@ -51,15 +75,40 @@ namespace Proto
 		void                CreateAll();
 		void                DeleteAll();
 		void                UpdateAll(const f32 & t_DeltaTime);
-        void                DrawAll(const mat4& viewMatrix);
+        // draws the objects inside the frustum of projMatrix * viewMatrix
+        void                DrawAll(const mat4& viewMatrix, const mat4& projMatrix);
 		void                UpdateRotation(const vec3& rotVec);
  
 
-        void                AddSceneObject(SceneObject * t_Inst);
+        SceneObjectHandle   AddSceneObject(SceneObject * t_Inst);
+        void                RemoveSceneObject(SceneObjectHandle t_Handle);
         void                RemoveSceneObject(const str & t_InstName);
 
+        // names are only resolved at load time and from the UI
+        SceneObjectHandle   FindSceneObject(const str & t_InstName) const;
+        SceneObject *       GetSceneObject(SceneObjectHandle t_Handle) const;
+        bool                IsValid(SceneObjectHandle t_Handle) const;
+
 		size_t				GetNumberofSceneObjects();
 
+        // packed per-object data, index 0 .. GetNumberofSceneObjects() - 1;
+        // removing an object moves the last one into its place
+        SceneObject *       GetSceneObjectAt(u32 t_Index) const;
+        SceneObjectHandle   GetHandleAt(u32 t_Index) const;
+        const mat4 &        GetWorldMatrixAt(u32 t_Index) const;
+        const AABB &        GetWorldAABBAt(u32 t_Index) const;
+        bool                IsDirtyAt(u32 t_Index) const;   // moved in the last UpdateAll
+
+        // BroadphaseType::*; switching re-inserts every object
+        void                SetBroadphase(u32 t_Type);
+        f32                 GetBroadphaseMs() const;        // pair search of the last UpdateAll
+        u32                 GetBroadphasePairCount() const;
+
+        // ray queries against every object, kept in step with UpdateAll
+        ISceneGraph &       GetSceneGraph();
+
+        u32                 GetInstancedDrawCount() const;  // draws issued by the last DrawAll, debug boxes included
+
 		// Update screen items
 		void updateScreenItems(float deltaTime);
 
@@ -68,8 +117,6 @@ namespace Proto
 		size_t GetRenderObjCount();
 		void incrementRenderObjCount();
 		void decrementRenderObjCount();
-		GOINST_CONT         m_AllActiveObj;
-		std::vector<SceneObject*> m_RenderList;
 	private:
         
         SceneObjectManager();
@@ -83,24 +130,43 @@ namespace Proto
 		// Remove screen items check
 		void removeScreenItemsCheck();
 
-
-     
-
-        template<typename Container, typename T>
-        void UpdateObj(Container & t_Container, const f32 & t_DeltaTime)
-        {
-            Container::iterator t_Iter = t_Container.begin();
-            Container::iterator t_End = t_Container.end();
-
-            for (; t_Iter != t_End; ++t_Iter)
-            {
-                T * t_Obj = t_Iter->second;
-                t_Obj->Update(t_DeltaTime);
-                
-
-                  
-            }
-        }
+        void                DrawDebugBoxes(const mat4& viewMatrix);
+
+        // handle slots, m_SlotIndices maps a slot to its packed index
+        std::vector<u32>                m_SlotGenerations;
+        std::vector<u32>                m_SlotIndices;
+        std::vector<u32>                m_FreeSlots;
+
+        // packed arrays, one entry per live object in render order
+        std::vector<SceneObject *>      m_Objects;
+        std::vector<u32>                m_Slots;
+        std::vector<mat4>               m_WorldMatrices;
+        std::vector<AABB>               m_WorldAABBs;
+        std::vector<u8>                 m_Dirty;
+
+        std::unordered_map<str, SceneObjectHandle>  m_NameLookup;
+
+        // world boxes keyed by handle slot
+        SweepAndPrune                   m_SweepAndPrune;
+        SpatialHash                     m_SpatialHash;
+        IBroadphase *                   m_Broadphase;
+        u32                             m_BroadphaseType;
+        f32                             m_BroadphaseMs;
+        u32                             m_BroadphasePairCount;
+
+        BVHSceneGraph                   m_SceneGraph;
+        std::vector<SceneObject *>      m_VisibleObjects;   // DrawAll scratch
+
+        // objects drawn in instanced groups, keyed by handle slot
+        InstanceBatches                 m_InstanceBatches;
+        std::vector<u8>                 m_SlotVisible;      // DrawAll scratch
+
+        // debug boxes of every object, refilled and drawn once per frame
+        std::vector<InstanceData>       m_DebugBoxes;
+        Model *                         m_DebugBoxModel;    // MODEL_DCUBE
+        GLuint                          m_DebugBoxVBO;
+        u32                             m_DebugBoxCapacity; // boxes the GPU buffer holds
+        u32                             m_DebugBoxDrawCount;
 	};
 }
 
@@ -0,0 +1,238 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      SpatialHash.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include <cmath>
+#include <algorithm>
+#include <omp.h>
+#include "SpatialHash.h"
+
+namespace Proto
+{
+    namespace
+    {
+        u32 HashCell(const s32 t_Cell[3])
+        {
+            return (u32(t_Cell[0]) * 73856093u) ^ (u32(t_Cell[1]) * 19349663u) ^ (u32(t_Cell[2]) * 83492791u);
+        }
+
+        bool Overlaps(const vec3 & t_Min1, const vec3 & t_Max1, const vec3 & t_Min2, const vec3 & t_Max2)
+        {
+            return t_Min1.x <= t_Max2.x && t_Min2.x <= t_Max1.x &&
+                   t_Min1.y <= t_Max2.y && t_Min2.y <= t_Max1.y &&
+                   t_Min1.z <= t_Max2.z && t_Min2.z <= t_Max1.z;
+        }
+    }
+
+    void SpatialHash::Add(u32 t_Id, const AABB & t_Box)
+    {
+        if (t_Id >= m_Proxies.size())
+        {
+            Proxy t_Empty;
+            t_Empty.m_Active = false;
+            m_Proxies.resize(t_Id + 1, t_Empty);
+        }
+        m_Proxies[t_Id].m_Active = true;
+        Update(t_Id, t_Box);
+    }
+
+    void SpatialHash::Remove(u32 t_Id)
+    {
+        if (t_Id < m_Proxies.size())
+            m_Proxies[t_Id].m_Active = false;
+    }
+
+    void SpatialHash::Update(u32 t_Id, const AABB & t_Box)
+    {
+        Proxy & t_Proxy = m_Proxies[t_Id];
+        t_Proxy.m_Min = t_Box.m_Center - t_Box.m_Radius;
+        t_Proxy.m_Max = t_Box.m_Center + t_Box.m_Radius;
+    }
+
+    void SpatialHash::Clear()
+    {
+        m_Proxies.clear();
+        m_Pairs.clear();
+    }
+
+    void SpatialHash::CellRange(const Proxy & t_Proxy, s32 t_Min[3], s32 t_Max[3]) const
+    {
+        for (u32 a = 0; a < 3; ++a)
+        {
+            t_Min[a] = static_cast<s32>(floorf(t_Proxy.m_Min[a] / m_CellSize));
+            t_Max[a] = static_cast<s32>(floorf(t_Proxy.m_Max[a] / m_CellSize));
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn const BroadphasePairs & SpatialHash::FindPairs()
+
+    \brief
+        Rebuilds the grid from the current boxes and collects the pairs.
+        The buffers are kept between frames, so a steady scene does not
+        allocate.
+    */
+    /*************************************************************************/
+    const BroadphasePairs & SpatialHash::FindPairs()
+    {
+        m_Pairs.clear();
+        m_Ids.clear();
+        m_Large.clear();
+
+        // cells as large as the mean box, so most boxes touch at most 8
+        f32 t_Extent = 0.f;
+        u32 t_Active = 0;
+        for (u32 i = 0; i < m_Proxies.size(); ++i)
+        {
+            if (!m_Proxies[i].m_Active)
+                continue;
+            vec3 t_Size = m_Proxies[i].m_Max - m_Proxies[i].m_Min;
+            t_Extent += std::max(std::max(t_Size.x, t_Size.y), t_Size.z);
+            ++t_Active;
+        }
+        if (t_Active < 2)
+            return m_Pairs;
+        m_CellSize = (t_Extent > 0.f) ? t_Extent / t_Active : 1.f;
+
+        for (u32 i = 0; i < m_Proxies.size(); ++i)
+        {
+            if (!m_Proxies[i].m_Active)
+                continue;
+
+            s32 t_Min[3], t_Max[3];
+            CellRange(m_Proxies[i], t_Min, t_Max);
+            bool t_IsLarge = false;
+            for (u32 a = 0; a < 3; ++a)
+                t_IsLarge = t_IsLarge || (t_Max[a] - t_Min[a] + 1 > SPATIAL_HASH_MAX_SPAN);
+            (t_IsLarge ? m_Large : m_Ids).push_back(i);
+        }
+
+        // one entry per (cell, box)
+        s32 t_IdCount = static_cast<s32>(m_Ids.size());
+        m_EntryOffsets.resize(t_IdCount + 1);
+        m_EntryOffsets[0] = 0;
+#pragma omp parallel for
+        for (s32 i = 0; i < t_IdCount; ++i)
+        {
+            s32 t_Min[3], t_Max[3];
+            CellRange(m_Proxies[m_Ids[i]], t_Min, t_Max);
+            m_EntryOffsets[i + 1] = (t_Max[0] - t_Min[0] + 1) * (t_Max[1] - t_Min[1] + 1) * (t_Max[2] - t_Min[2] + 1);
+        }
+        for (s32 i = 0; i < t_IdCount; ++i)
+            m_EntryOffsets[i + 1] += m_EntryOffsets[i];
+
+        u32 t_EntryCount = m_EntryOffsets[t_IdCount];
+        m_Entries.resize(t_EntryCount);
+#pragma omp parallel for
+        for (s32 i = 0; i < t_IdCount; ++i)
+        {
+            s32 t_Min[3], t_Max[3];
+            CellRange(m_Proxies[m_Ids[i]], t_Min, t_Max);
+
+            Entry * t_Entry = &m_Entries[m_EntryOffsets[i]];
+            for (s32 z = t_Min[2]; z <= t_Max[2]; ++z)
+                for (s32 y = t_Min[1]; y <= t_Max[1]; ++y)
+                    for (s32 x = t_Min[0]; x <= t_Max[0]; ++x, ++t_Entry)
+                    {
+                        t_Entry->m_Id = m_Ids[i];
+                        t_Entry->m_Cell[0] = x;
+                        t_Entry->m_Cell[1] = y;
+                        t_Entry->m_Cell[2] = z;
+                    }
+        }
+
+        // counting sort of the entries by bucket; after the scatter,
+        // bucket b spans [m_BucketOffsets[b - 1], m_BucketOffsets[b])
+        u32 t_BucketCount = 1;
+        while (t_BucketCount < t_EntryCount * 2)
+            t_BucketCount <<= 1;
+        u32 t_Mask = t_BucketCount - 1;
+
+        m_BucketOffsets.assign(t_BucketCount + 1, 0);
+        for (u32 i = 0; i < t_EntryCount; ++i)
+            ++m_BucketOffsets[(HashCell(m_Entries[i].m_Cell) & t_Mask) + 1];
+        for (u32 i = 0; i < t_BucketCount; ++i)
+            m_BucketOffsets[i + 1] += m_BucketOffsets[i];
+        m_Buckets.resize(t_EntryCount);
+        for (u32 i = 0; i < t_EntryCount; ++i)
+            m_Buckets[m_BucketOffsets[HashCell(m_Entries[i].m_Cell) & t_Mask]++] = i;
+
+        m_ThreadPairs.resize(omp_get_max_threads());
+        for (u32 i = 0; i < m_ThreadPairs.size(); ++i)
+            m_ThreadPairs[i].clear();
+
+        s32 t_Buckets = static_cast<s32>(t_BucketCount);
+        s32 t_LargeCount = static_cast<s32>(m_Large.size());
+#pragma omp parallel
+        {
+            BroadphasePairs & t_Out = m_ThreadPairs[omp_get_thread_num()];
+
+#pragma omp for schedule(dynamic, 256)
+            for (s32 b = 0; b < t_Buckets; ++b)
+            {
+                u32 t_End = m_BucketOffsets[b];
+                for (u32 i = b ? m_BucketOffsets[b - 1] : 0; i < t_End; ++i)
+                {
+                    const Entry & t_Entry1 = m_Entries[m_Buckets[i]];
+                    const Proxy & t_Proxy1 = m_Proxies[t_Entry1.m_Id];
+
+                    for (u32 j = i + 1; j < t_End; ++j)
+                    {
+                        const Entry & t_Entry2 = m_Entries[m_Buckets[j]];
+                        if (t_Entry1.m_Cell[0] != t_Entry2.m_Cell[0] ||
+                            t_Entry1.m_Cell[1] != t_Entry2.m_Cell[1] ||
+                            t_Entry1.m_Cell[2] != t_Entry2.m_Cell[2])
+                            continue;
+
+                        const Proxy & t_Proxy2 = m_Proxies[t_Entry2.m_Id];
+                        if (!Overlaps(t_Proxy1.m_Min, t_Proxy1.m_Max, t_Proxy2.m_Min, t_Proxy2.m_Max))
+                            continue;
+
+                        // only the cell holding the low corner of the
+                        // intersection reports the pair
+                        bool t_Owner = true;
+                        for (u32 a = 0; a < 3 && t_Owner; ++a)
+                        {
+                            f32 t_Low = std::max(t_Proxy1.m_Min[a], t_Proxy2.m_Min[a]);
+                            t_Owner = static_cast<s32>(floorf(t_Low / m_CellSize)) == t_Entry1.m_Cell[a];
+                        }
+                        if (t_Owner)
+                            t_Out.push_back(BroadphasePair(std::min(t_Entry1.m_Id, t_Entry2.m_Id),
+                                                           std::max(t_Entry1.m_Id, t_Entry2.m_Id)));
+                    }
+                }
+            }
+
+            // boxes off the grid against every box, each large pair once
+#pragma omp for schedule(dynamic, 16)
+            for (s32 i = 0; i < t_LargeCount; ++i)
+            {
+                u32 t_Id = m_Large[i];
+                const Proxy & t_Proxy = m_Proxies[t_Id];
+
+                for (u32 j = 0; j < m_Ids.size(); ++j)
+                {
+                    const Proxy & t_Other = m_Proxies[m_Ids[j]];
+                    if (Overlaps(t_Proxy.m_Min, t_Proxy.m_Max, t_Other.m_Min, t_Other.m_Max))
+                        t_Out.push_back(BroadphasePair(std::min(t_Id, m_Ids[j]), std::max(t_Id, m_Ids[j])));
+                }
+                for (s32 j = i + 1; j < t_LargeCount; ++j)
+                {
+                    const Proxy & t_Other = m_Proxies[m_Large[j]];
+                    if (Overlaps(t_Proxy.m_Min, t_Proxy.m_Max, t_Other.m_Min, t_Other.m_Max))
+                        t_Out.push_back(BroadphasePair(std::min(t_Id, m_Large[j]), std::max(t_Id, m_Large[j])));
+                }
+            }
+        }
+
+        // sorted, so the narrowphase order does not depend on the threads
+        for (u32 i = 0; i < m_ThreadPairs.size(); ++i)
+            m_Pairs.insert(m_Pairs.end(), m_ThreadPairs[i].begin(), m_ThreadPairs[i].end());
+        std::sort(m_Pairs.begin(), m_Pairs.end());
+
+        return m_Pairs;
+    }
+}
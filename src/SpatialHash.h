@@ -0,0 +1,73 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      SpatialHash.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _SPATIALHASH_H_
+#define _SPATIALHASH_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "IBroadphase.h"
+
+#define SPATIAL_HASH_MAX_SPAN 4     // boxes spanning more cells per axis are tested on their own
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Hashed uniform grid broadphase, for many objects of similar size.
+    // Every FindPairs sizes the cells from the mean box extent, writes one
+    // entry per (cell, box) and buckets the entries by cell hash. Buckets
+    // are then scanned in parallel. A pair sharing several cells is only
+    // reported from the cell holding the low corner of the two boxes'
+    // intersection, so no pair needs to be looked up to de-duplicate.
+    // Boxes far larger than the cells are kept off the grid and tested
+    // against every other box instead.
+    class SpatialHash : public IBroadphase
+    {
+        public:
+
+            virtual void                    Add(u32 t_Id, const AABB & t_Box);
+            virtual void                    Remove(u32 t_Id);
+            virtual void                    Update(u32 t_Id, const AABB & t_Box);
+            virtual void                    Clear();
+
+            virtual const BroadphasePairs & FindPairs();
+
+        private:
+
+            struct Proxy
+            {
+                vec3    m_Min;
+                vec3    m_Max;
+                bool    m_Active;
+            };
+
+            struct Entry
+            {
+                u32     m_Id;
+                s32     m_Cell[3];
+            };
+
+            void                    CellRange(const Proxy & t_Proxy, s32 t_Min[3], s32 t_Max[3]) const;
+
+            std::vector<Proxy>              m_Proxies;      // indexed by id
+            std::vector<u32>                m_Ids;          // active ids on the grid
+            std::vector<u32>                m_Large;        // active ids off the grid
+            std::vector<u32>                m_EntryOffsets; // first entry of each m_Ids
+            std::vector<Entry>              m_Entries;
+            std::vector<u32>                m_BucketOffsets;
+            std::vector<u32>                m_Buckets;      // entry indices grouped by bucket
+            std::vector<BroadphasePairs>    m_ThreadPairs;
+            BroadphasePairs                 m_Pairs;
+            f32                             m_CellSize;
+    };
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      SweepAndPrune.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include "SweepAndPrune.h"
+
+namespace Proto
+{
+    namespace
+    {
+        bool EndpointLess(f32 t_Value1, u32 t_Data1, f32 t_Value2, u32 t_Data2)
+        {
+            if (t_Value1 != t_Value2)
+                return t_Value1 < t_Value2;
+            return (t_Data1 & 0x80000000u) < (t_Data2 & 0x80000000u);
+        }
+    }
+
+    void SweepAndPrune::Add(u32 t_Id, const AABB & t_Box)
+    {
+        if (t_Id >= m_Proxies.size())
+        {
+            Proxy t_Empty;
+            t_Empty.m_Active = false;
+            m_Proxies.resize(t_Id + 1, t_Empty);
+        }
+        if (m_Proxies[t_Id].m_Active)
+            return;
+
+        m_Proxies[t_Id].m_Active = true;
+        Update(t_Id, t_Box);
+
+        // the new endpoints are sorted into place by the next FindPairs
+        Endpoint t_Endpoint;
+        t_Endpoint.m_Value = m_Proxies[t_Id].m_Min.x;
+        t_Endpoint.m_Data = t_Id;
+        m_Endpoints.push_back(t_Endpoint);
+        t_Endpoint.m_Value = m_Proxies[t_Id].m_Max.x;
+        t_Endpoint.m_Data = t_Id | MAX_ENDPOINT;
+        m_Endpoints.push_back(t_Endpoint);
+    }
+
+    void SweepAndPrune::Remove(u32 t_Id)
+    {
+        if (t_Id >= m_Proxies.size() || !m_Proxies[t_Id].m_Active)
+            return;
+
+        m_Proxies[t_Id].m_Active = false;
+
+        // keeps the remaining endpoints in order
+        u32 t_Kept = 0;
+        for (u32 i = 0; i < m_Endpoints.size(); ++i)
+        {
+            if ((m_Endpoints[i].m_Data & ~MAX_ENDPOINT) != t_Id)
+                m_Endpoints[t_Kept++] = m_Endpoints[i];
+        }
+        m_Endpoints.resize(t_Kept);
+    }
+
+    void SweepAndPrune::Update(u32 t_Id, const AABB & t_Box)
+    {
+        Proxy & t_Proxy = m_Proxies[t_Id];
+        t_Proxy.m_Min = t_Box.m_Center - t_Box.m_Radius;
+        t_Proxy.m_Max = t_Box.m_Center + t_Box.m_Radius;
+    }
+
+    void SweepAndPrune::Clear()
+    {
+        m_Proxies.clear();
+        m_Endpoints.clear();
+        m_Pairs.clear();
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn const BroadphasePairs & SweepAndPrune::FindPairs()
+
+    \brief
+        Refreshes and re-sorts the endpoints, then sweeps them. The result
+        stays valid until the next call.
+    */
+    /*************************************************************************/
+    const BroadphasePairs & SweepAndPrune::FindPairs()
+    {
+        u32 t_Count = m_Endpoints.size();
+
+        // insertion sort, nearly sorted already from the last frame
+        for (u32 i = 0; i < t_Count; ++i)
+        {
+            Endpoint t_Endpoint = m_Endpoints[i];
+            const Proxy & t_Proxy = m_Proxies[t_Endpoint.m_Data & ~MAX_ENDPOINT];
+            t_Endpoint.m_Value = (t_Endpoint.m_Data & MAX_ENDPOINT) ? t_Proxy.m_Max.x : t_Proxy.m_Min.x;
+
+            u32 j = i;
+            for (; j > 0 && EndpointLess(t_Endpoint.m_Value, t_Endpoint.m_Data,
+                                         m_Endpoints[j - 1].m_Value, m_Endpoints[j - 1].m_Data); --j)
+                m_Endpoints[j] = m_Endpoints[j - 1];
+            m_Endpoints[j] = t_Endpoint;
+        }
+
+        m_Pairs.clear();
+        m_Open.clear();
+        for (u32 i = 0; i < t_Count; ++i)
+        {
+            u32 t_Id = m_Endpoints[i].m_Data & ~MAX_ENDPOINT;
+
+            if (m_Endpoints[i].m_Data & MAX_ENDPOINT)
+            {
+                for (u32 j = 0; j < m_Open.size(); ++j)
+                {
+                    if (m_Open[j] == t_Id)
+                    {
+                        m_Open[j] = m_Open.back();
+                        m_Open.pop_back();
+                        break;
+                    }
+                }
+                continue;
+            }
+
+            // every open box overlaps this one on x
+            const Proxy & t_Proxy = m_Proxies[t_Id];
+            for (u32 j = 0; j < m_Open.size(); ++j)
+            {
+                const Proxy & t_Other = m_Proxies[m_Open[j]];
+                if (t_Proxy.m_Min.y > t_Other.m_Max.y || t_Other.m_Min.y > t_Proxy.m_Max.y ||
+                    t_Proxy.m_Min.z > t_Other.m_Max.z || t_Other.m_Min.z > t_Proxy.m_Max.z)
+                    continue;
+
+                m_Pairs.push_back(BroadphasePair(std::min(t_Id, m_Open[j]), std::max(t_Id, m_Open[j])));
+            }
+            m_Open.push_back(t_Id);
+        }
+
+        return m_Pairs;
+    }
+}
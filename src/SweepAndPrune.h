@@ -0,0 +1,65 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      SweepAndPrune.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _SWEEPANDPRUNE_H_
+#define _SWEEPANDPRUNE_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "IBroadphase.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Sweep-and-prune broadphase over world-space boxes.
+    // The box endpoints along x are kept in one list that persists between
+    // frames and is re-sorted with an insertion sort; objects move little
+    // from frame to frame, so this is close to linear. A sweep over the
+    // sorted list then reports every pair overlapping on all three axes
+    // exactly once.
+    class SweepAndPrune : public IBroadphase
+    {
+        public:
+
+            virtual void                    Add(u32 t_Id, const AABB & t_Box);
+            virtual void                    Remove(u32 t_Id);
+            virtual void                    Update(u32 t_Id, const AABB & t_Box);
+            virtual void                    Clear();
+
+            virtual const BroadphasePairs & FindPairs();
+
+        private:
+
+            struct Proxy
+            {
+                vec3    m_Min;
+                vec3    m_Max;
+                bool    m_Active;
+            };
+
+            // top bit set for a max endpoint, so at equal values min sorts first
+            // and touching boxes count as overlapping
+            struct Endpoint
+            {
+                f32     m_Value;
+                u32     m_Data;
+            };
+
+            static const u32 MAX_ENDPOINT = 0x80000000u;
+
+            std::vector<Proxy>      m_Proxies;      // indexed by id
+            std::vector<Endpoint>   m_Endpoints;    // sorted on x
+            std::vector<u32>        m_Open;         // ids whose min was swept but not their max
+            BroadphasePairs         m_Pairs;
+    };
+}
+
+#endif
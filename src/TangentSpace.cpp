@@ -0,0 +1,140 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      TangentSpace.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include "TangentSpace.h"
+
+namespace Proto
+{
+    /*************************************************************************/
+    /*!
+    \fn void TangentSpace::SetTopology(u32 t_VertexCount,
+                                       const IndexBufferType & t_Indices)
+
+    \brief
+        Builds the vertex-to-triangle table with a counting sort. Each row
+        lists its triangles in ascending order.
+    */
+    /*************************************************************************/
+    void TangentSpace::SetTopology(u32 t_VertexCount, const IndexBufferType & t_Indices)
+    {
+        u32 t_Corners = static_cast<u32>(t_Indices.size() / 3) * 3;
+
+        m_Offsets.assign(t_VertexCount + 1, 0);
+        for (u32 i = 0; i < t_Corners; ++i)
+            ++m_Offsets[t_Indices[i] + 1];
+        for (u32 i = 0; i < t_VertexCount; ++i)
+            m_Offsets[i + 1] += m_Offsets[i];
+
+        m_Triangles.resize(t_Corners);
+        std::vector<u32> t_Cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+        for (u32 i = 0; i < t_Corners; ++i)
+            m_Triangles[t_Cursor[t_Indices[i]]++] = i / 3;
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void TangentSpace::ComputeNormals(VertexBufferType & t_Vertices,
+                                          const IndexBufferType & t_Indices)
+
+    \brief
+        Face normals are left unnormalised, so larger triangles weigh more.
+    */
+    /*************************************************************************/
+    void TangentSpace::ComputeNormals(VertexBufferType & t_Vertices, const IndexBufferType & t_Indices)
+    {
+        s32 t_TriangleCount = static_cast<s32>(t_Indices.size() / 3);
+        m_FaceNormals.resize(t_TriangleCount);
+
+#pragma omp parallel for
+        for (s32 i = 0; i < t_TriangleCount; ++i)
+        {
+            const Vec3 & a = t_Vertices[t_Indices[i * 3]].pos;
+            const Vec3 & b = t_Vertices[t_Indices[i * 3 + 1]].pos;
+            const Vec3 & c = t_Vertices[t_Indices[i * 3 + 2]].pos;
+            m_FaceNormals[i] = glm::cross(b - a, c - a);
+        }
+
+        s32 t_VertexCount = static_cast<s32>(m_Offsets.size()) - 1;
+#pragma omp parallel for
+        for (s32 i = 0; i < t_VertexCount; ++i)
+        {
+            Vec3 normal(0.f);
+            for (u32 j = m_Offsets[i]; j < m_Offsets[i + 1]; ++j)
+                normal += m_FaceNormals[m_Triangles[j]];
+
+            f32 length = glm::length(normal);
+            if (length > 0.f)
+                t_Vertices[i].nrm = normal / length;
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void TangentSpace::ComputeTangents(VertexBufferType & t_Vertices,
+                                           const IndexBufferType & t_Indices)
+
+    \brief
+        Per-triangle UV gradients summed on the vertices, then made
+        orthogonal to the normal, the way aiProcess_CalcTangentSpace does.
+        Only the sign of the UV determinant is used, so triangles with tiny
+        UV areas do not blow up; triangles with none are skipped.
+    */
+    /*************************************************************************/
+    void TangentSpace::ComputeTangents(VertexBufferType & t_Vertices, const IndexBufferType & t_Indices)
+    {
+        s32 t_TriangleCount = static_cast<s32>(t_Indices.size() / 3);
+        m_FaceTangents.resize(t_TriangleCount);
+        m_FaceBitangents.resize(t_TriangleCount);
+
+#pragma omp parallel for
+        for (s32 i = 0; i < t_TriangleCount; ++i)
+        {
+            const Vertex & a = t_Vertices[t_Indices[i * 3]];
+            const Vertex & b = t_Vertices[t_Indices[i * 3 + 1]];
+            const Vertex & c = t_Vertices[t_Indices[i * 3 + 2]];
+
+            Vec3 v = b.pos - a.pos, w = c.pos - a.pos;
+            f32 sx = b.uv.x - a.uv.x, sy = b.uv.y - a.uv.y;
+            f32 tx = c.uv.x - a.uv.x, ty = c.uv.y - a.uv.y;
+            f32 determinant = sx * ty - tx * sy;
+            f32 direction = (determinant < 0.f) ? -1.f : ((determinant > 0.f) ? 1.f : 0.f);
+
+            m_FaceTangents[i] = (v * ty - w * sy) * direction;
+            m_FaceBitangents[i] = (w * sx - v * tx) * direction;
+        }
+
+        s32 t_VertexCount = static_cast<s32>(m_Offsets.size()) - 1;
+#pragma omp parallel for
+        for (s32 i = 0; i < t_VertexCount; ++i)
+        {
+            Vec3 tangent(0.f), bitangent(0.f);
+            for (u32 j = m_Offsets[i]; j < m_Offsets[i + 1]; ++j)
+            {
+                tangent += m_FaceTangents[m_Triangles[j]];
+                bitangent += m_FaceBitangents[m_Triangles[j]];
+            }
+
+            Vertex & vertex = t_Vertices[i];
+            tangent -= vertex.nrm * glm::dot(vertex.nrm, tangent);
+            bitangent -= vertex.nrm * glm::dot(vertex.nrm, bitangent);
+
+            f32 tangentLength = glm::length(tangent);
+            f32 bitangentLength = glm::length(bitangent);
+            vertex.tan = (tangentLength > 0.f) ? tangent / tangentLength : Vec3(0.f);
+            vertex.bitan = (bitangentLength > 0.f) ? bitangent / bitangentLength : Vec3(0.f);
+        }
+    }
+
+    void ComputeTangentSpace(Mesh & t_Mesh, bool t_Normals, bool t_Tangents)
+    {
+        TangentSpace t_TangentSpace;
+        t_TangentSpace.SetTopology(t_Mesh.vertexBuffer.size(), t_Mesh.indexBuffer);
+        if (t_Normals)
+            t_TangentSpace.ComputeNormals(t_Mesh.vertexBuffer, t_Mesh.indexBuffer);
+        if (t_Tangents)
+            t_TangentSpace.ComputeTangents(t_Mesh.vertexBuffer, t_Mesh.indexBuffer);
+    }
+}
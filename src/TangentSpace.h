@@ -0,0 +1,58 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      TangentSpace.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _TANGENTSPACE_H_
+#define _TANGENTSPACE_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include "Mesh.hpp"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Per-vertex normals and tangent frames of an indexed triangle mesh.
+    // Both are built in two parallel passes without any scattered writes:
+    // one thread per triangle for the face terms, then one thread per
+    // vertex summing the faces around it through a vertex-to-triangle
+    // table. The sums run in triangle order, so results do not depend on
+    // the thread count.
+    // The table only depends on the index buffer; keep the object around
+    // while the topology stays the same (e.g. cloth) so nothing is
+    // reallocated between updates.
+    class TangentSpace
+    {
+        public:
+
+            void    SetTopology(u32 t_VertexCount, const IndexBufferType & t_Indices);
+
+            // area weighted vertex normals; vertices on no triangle keep theirs
+            void    ComputeNormals(VertexBufferType & t_Vertices, const IndexBufferType & t_Indices);
+
+            // unit tangent/bitangent from the UV gradients, orthogonal to nrm
+            void    ComputeTangents(VertexBufferType & t_Vertices, const IndexBufferType & t_Indices);
+
+        private:
+
+            // triangles of vertex v are m_Triangles[m_Offsets[v], m_Offsets[v + 1])
+            std::vector<u32>    m_Offsets;
+            std::vector<u32>    m_Triangles;
+
+            PositionBufferType  m_FaceNormals;
+            PositionBufferType  m_FaceTangents;
+            PositionBufferType  m_FaceBitangents;
+    };
+
+    // one-off helper for freshly built meshes
+    void    ComputeTangentSpace(Mesh & t_Mesh, bool t_Normals, bool t_Tangents);
+}
+
+#endif
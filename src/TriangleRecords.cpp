@@ -0,0 +1,155 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      TriangleRecords.cpp
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#include "TriangleRecords.h"
+
+namespace Proto
+{
+    /*************************************************************************/
+    /*!
+    \fn void TriangleRecords::Build(const PositionBufferType & t_Positions, 
+                                    HierachicalAABB & t_Tree)
+
+    \brief
+        Builds the records of every leaf triangle of t_Tree, leaf by leaf,
+        and stores each leaf's range back into the tree.
+    */
+    /*************************************************************************/
+    void TriangleRecords::Build(const PositionBufferType & t_Positions, HierachicalAABB & t_Tree)
+    {
+        AssignLeafRanges(t_Tree);
+        u32 total = 0;
+        for (u32 i = 0; i < t_Tree.nodes.size(); ++i)
+            total += t_Tree.nodes[i].triangleCount;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            m_V0[axis].clear();     m_V0[axis].reserve(total);
+            m_Edge1[axis].clear();  m_Edge1[axis].reserve(total);
+            m_Edge2[axis].clear();  m_Edge2[axis].reserve(total);
+            m_Normal[axis].clear(); m_Normal[axis].reserve(total);
+        }
+
+        for (u32 i = 0; i < t_Tree.nodes.size(); ++i)
+        {
+            const HierachicalAABBNode& node = t_Tree.nodes[i];
+            for (u32 j = 0; j < node.triangleIndices.size(); ++j)
+            {
+                const std::array<int, 3>& triangle = node.triangleIndices[j];
+                Add(t_Positions[triangle[0]], t_Positions[triangle[1]], t_Positions[triangle[2]]);
+            }
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn void TriangleRecords::AssignLeafRanges(HierachicalAABB & t_Tree)
+
+    \brief
+        Stores the range each node's triangles take in the records, which
+        are laid out node by node. Used on its own by paged models, whose 
+        records are never built in memory.
+    */
+    /*************************************************************************/
+    void TriangleRecords::AssignLeafRanges(HierachicalAABB & t_Tree)
+    {
+        u32 start = 0;
+        for (u32 i = 0; i < t_Tree.nodes.size(); ++i)
+        {
+            HierachicalAABBNode& node = t_Tree.nodes[i];
+            node.triangleStart = start;
+            node.triangleCount = node.triangleIndices.size();
+            start += node.triangleCount;
+        }
+    }
+
+    u32 TriangleRecords::Size() const
+    {
+        return m_V0[0].size();
+    }
+
+    void TriangleRecords::Add(const vec3 & t_V0, const vec3 & t_V1, const vec3 & t_V2)
+    {
+        vec3 edge1 = t_V1 - t_V0;
+        vec3 edge2 = t_V2 - t_V0;
+        vec3 normal = Cross(edge1, edge2);
+        f32 length = glm::length(normal);
+        normal = (length > 0.f) ? normal / length : vec3(0.f);
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            m_V0[axis].push_back(t_V0[axis]);
+            m_Edge1[axis].push_back(edge1[axis]);
+            m_Edge2[axis].push_back(edge2[axis]);
+            m_Normal[axis].push_back(normal[axis]);
+        }
+    }
+
+    /*************************************************************************/
+    /*!
+    \fn bool TriangleRecords::IntersectLine(u32 t_Index, const vec3 & t_Origin,
+                                            const vec3 & t_Ray, f32 t_MaxDistance,
+                                            f32 & t_Time) const
+
+    \brief
+        Intersects the line t_Origin + t * t_Ray with a triangle, in both 
+        directions at once. Same test as IntersectRayTriangle, except that
+        the plane distance is checked against t_MaxDistance before the 
+        barycentric coordinates are worked out.
+
+    \param t_Time
+        Receives t, negative when the triangle is behind t_Origin.
+
+    \return
+        true if the triangle is hit with |t| < t_MaxDistance.
+    */
+    /*************************************************************************/
+    bool TriangleRecords::IntersectLine(u32 t_Index, const vec3 & t_Origin, const vec3 & t_Ray,
+                                        f32 t_MaxDistance, f32 & t_Time) const
+    {
+        f32 nx = m_Normal[0][t_Index], ny = m_Normal[1][t_Index], nz = m_Normal[2][t_Index];
+
+        // check if ray and plane are parallel
+        f32 nDotRay = nx * t_Ray.x + ny * t_Ray.y + nz * t_Ray.z;
+        if (fabs(nDotRay) < EPSILON)
+            return false;
+
+        // origin relative to v0
+        f32 rx = t_Origin.x - m_V0[0][t_Index];
+        f32 ry = t_Origin.y - m_V0[1][t_Index];
+        f32 rz = t_Origin.z - m_V0[2][t_Index];
+
+        f32 t = -(nx * rx + ny * ry + nz * rz) / nDotRay;
+        if (fabs(t) >= t_MaxDistance)
+            return false;
+
+        // intersection point relative to v0
+        rx += t * t_Ray.x;
+        ry += t * t_Ray.y;
+        rz += t * t_Ray.z;
+
+        f32 e1x = m_Edge1[0][t_Index], e1y = m_Edge1[1][t_Index], e1z = m_Edge1[2][t_Index];
+        f32 e2x = m_Edge2[0][t_Index], e2y = m_Edge2[1][t_Index], e2z = m_Edge2[2][t_Index];
+
+        f32 d0 = rx * e1x + ry * e1y + rz * e1z;
+        f32 d1 = rx * e2x + ry * e2y + rz * e2z;
+        f32 q1q2 = e1x * e2x + e1y * e2y + e1z * e2z;
+        f32 q1Sq = e1x * e1x + e1y * e1y + e1z * e1z;
+        f32 q2Sq = e2x * e2x + e2y * e2y + e2z * e2z;
+
+        f32 det = q1Sq * q2Sq - q1q2 * q1q2;
+        if (det == 0.f)
+            return false;
+
+        f32 u = (q2Sq * d0 - q1q2 * d1) / det;
+        f32 v = (q1Sq * d1 - q1q2 * d0) / det;
+        if (u < 0.f || v < 0.f || u + v > 1.f)
+            return false;
+
+        t_Time = t;
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+/*  Start Header -------------------------------------------------------
+    File Name:      TriangleRecords.h
+    Author:         Tan Wen De Kevin
+    Creation Date:  19/Oct/2026
+    - End Header -------------------------------------------------------*/
+
+#ifndef _TRIANGLERECORDS_H_
+#define _TRIANGLERECORDS_H_
+
+// ==========================
+// includes
+// ==========================
+
+#include <vector>
+#include "Mesh.hpp"
+#include "HierachicalAABB.h"
+
+// ==========================
+// class/ function prototypes
+// ==========================
+
+namespace Proto
+{
+    // Precomputed triangles of a model, stored in the leaf order of its 
+    // hierachical AABB with one contiguous array per component. 
+    // Each leaf refers to its triangles by triangleStart/triangleCount.
+    class TriangleRecords
+    {
+        public:
+
+            void            Build(const PositionBufferType & t_Positions, HierachicalAABB & t_Tree);
+            static void     AssignLeafRanges(HierachicalAABB & t_Tree);
+            u32             Size() const;
+
+            bool            IntersectLine(u32 t_Index, const vec3 & t_Origin, const vec3 & t_Ray,
+                                          f32 t_MaxDistance, f32 & t_Time) const;
+
+            std::vector<f32>    m_V0[3];
+            std::vector<f32>    m_Edge1[3];     // v1 - v0
+            std::vector<f32>    m_Edge2[3];     // v2 - v0
+            std::vector<f32>    m_Normal[3];    // unit plane normal
+
+        private:
+
+            void            Add(const vec3 & t_V0, const vec3 & t_V1, const vec3 & t_V2);
+    };
+}
+
+#endif
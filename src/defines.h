@@ -7,6 +7,15 @@ Creation Date:  24/Sep/2016
 #ifndef _DEFINES_H_
 #define _DEFINES_H_
 #define CLOTH_SIM 1
+// sort triangles along a Morton curve before the vertex cache pass at load
+#define MESH_MORTON_ORDER 1
+// build a chain of simplified levels for every loaded model
+#define MESH_BUILD_LODS 1
+// models with at least this many triangles are converted to paged (out-of-core) form, 0 disables
+#define MESH_PAGE_MIN_TRIANGLES 2000000
+// count every operator new, to show allocations per frame on the tweak bar; a
+// profiling aid, it replaces the global operator new/delete when enabled
+#define TRACK_ALLOCATIONS 0
 // ==========================
 // includes
 // ==========================
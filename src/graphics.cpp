@@ -14,6 +14,7 @@
 #include <iostream>
 #include <ctime>
 #include <map>
+#include <algorithm>
 #include "graphics.hpp"
 #include "Camera.hpp"
 #include "textfile.h"
@@ -25,6 +26,10 @@
 #include "SceneObjectManager.h"
 #include "Collision.h"
 #include "HierachicalAABB.h"
+#include "HeatMapWorker.h"
+#include "HeatMapTracker.h"
+#include "MeshPages.h"
+#include "AllocationCounter.h"
 
 
 /******************************************************************************/
@@ -61,6 +66,7 @@ Proto::SceneObject sceneObject2;
 Proto::SceneObject teapotObj;
 Proto::SceneObject bunnyObj;
 std::vector<Proto::SceneObject> vecSceneObjects;
+Proto::SceneObjectHandle sphereHandle;  // resolved once after loading
 
 const int maxObjCount = 50;
 const int maxj = 5;
@@ -102,6 +108,27 @@ GLint normalMappingOnLoc, parallaxMappingOnLoc;
 //depth of BSP
 u8 u8CurrentBSPDepth = 1;
 bool boRotateModels = false;
+//progressive heatmap, milliseconds of worker time per preview
+bool progressiveHeatMap = true;
+f32 heatMapFrameBudget = 4.f;
+//only surfaces within this distance show on the heatmap
+f32 heatMapTolerance = 0.5f;
+//what each heatmap result was last computed from
+Proto::HeatMapTracker heatMapTracker;
+//switch to a coarser LOD while its error stays under this many pixels
+bool useLOD = true;
+f32 lodPixelError = 1.f;
+//memory budget for the pages of out-of-core models, and its current use
+u32 pageCacheBudgetMB = 256;
+f32 pageCacheResidentMB = 0.f;
+//heap allocations made during the last frame, by any thread
+u32 allocationsPerFrame = 0;
+//broadphase in front of the hierarchical collision test, and its cost
+s32 broadphaseType = Proto::BroadphaseType::SWEEP_AND_PRUNE;
+f32 broadphaseMs = 0.f;
+u32 broadphasePairs = 0;
+//instanced draws issued for the scene objects in the last frame
+u32 instancedDrawCalls = 0;
 const vec3 rotVec = vec3(PI*0.001f, PI*0.001f, PI*0.001f);
 
 struct ShaderType
@@ -129,8 +156,8 @@ GLuint prog[ProgType::NUM_PROGTYPES];
 /*  Locations of the variables in the shader. */
 /*  Locations of transform matrices */
 GLint mainMVMatLoc, mainNMVMatLoc, mainProjMatLoc, objectColorLoc;  /*  used for main program */
+GLint mainViewMatLoc, instancingOnLoc;                             /*  used by instanced draws */
 
-void updateHeatMap(Proto::SceneObject* shadedObject, Proto::SceneObject* opposingObject);
 
 /******************************************************************************/
 /*!
@@ -265,6 +292,8 @@ void SetUpMainUniformLocations(GLuint prog)
     mainMVMatLoc	= glGetUniformLocation(prog, "mvMat");
     mainNMVMatLoc	= glGetUniformLocation(prog, "nmvMat");
     mainProjMatLoc	= glGetUniformLocation(prog, "projMat");
+    mainViewMatLoc	= glGetUniformLocation(prog, "viewMat");
+    instancingOnLoc	= glGetUniformLocation(prog, "instancingOn");
 
     textureLoc		= glGetUniformLocation(prog, "colorTex");
 	textureOnLoc	= glGetUniformLocation(prog, "textureOn");
@@ -325,6 +354,36 @@ void SetUpVertexData(Mesh &mesh)
         glVertexAttribPointer(  vLayout[i].location, vLayout[i].size, vLayout[i].type, 
                                 vLayout[i].normalized, vertexSize, (void*)vLayout[i].offset);
     }
+
+    SetUpHeatMapStream(mesh);
+}
+
+
+/******************************************************************************/
+/*!
+\fn     void SetUpHeatMapStream(Mesh &mesh)
+\brief
+        Create the separate heatmap VBO of the mesh and attach it to the 
+        currently bound VAO. The stream is hinted as dynamic since it is 
+        rewritten every time the heatmap is recomputed.
+\param  mesh
+        The input mesh, whose heatmapBuffer/HeatMapVBO will be set up.
+*/
+/******************************************************************************/
+void SetUpHeatMapStream(Mesh &mesh)
+{
+    mesh.heatmapBuffer.assign(mesh.vertexBuffer.size(), HeatMapValue(0.f, 0.f));
+
+    glGenBuffers(1, &mesh.HeatMapVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.HeatMapVBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                    mesh.heatmapBuffer.size() * heatmapSize, 
+                    mesh.heatmapBuffer.empty() ? nullptr : &mesh.heatmapBuffer[0],
+                    GL_DYNAMIC_DRAW);
+
+    glEnableVertexAttribArray(heatmapLayout.location);
+    glVertexAttribPointer(  heatmapLayout.location, heatmapLayout.size, heatmapLayout.type,
+                            heatmapLayout.normalized, heatmapSize, (void*)heatmapLayout.offset);
 }
 
 void UpdateGPUMesh(const Mesh &mesh)
@@ -346,6 +405,28 @@ void UpdateGPUMesh(const Mesh &mesh)
 		GL_STATIC_DRAW);
 }
 
+
+/******************************************************************************/
+/*!
+\fn     void UpdateGPUHeatMap(const Mesh &mesh)
+\brief
+        Re-send only the heatmap stream of the mesh to the GPU. 
+        Positions, other attributes and indices are left untouched.
+\param  mesh
+        The mesh whose heatmapBuffer has been recomputed.
+*/
+/******************************************************************************/
+void UpdateGPUHeatMap(const Mesh &mesh)
+{
+	if (mesh.heatmapBuffer.empty())
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.HeatMapVBO);
+	glBufferSubData(GL_ARRAY_BUFFER, 0,
+		mesh.heatmapBuffer.size() * heatmapSize, &mesh.heatmapBuffer[0]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 /******************************************************************************/
 /*!
 \fn     void UpdateLightPosViewFrame()
@@ -652,6 +733,8 @@ void SetUp()
 /******************************************************************************/
 void CleanUp()
 {
+    Proto::HeatMapWorker::GetInstance().Shutdown();
+
     TwTerminate();      /*  Terminate AntTweakBar */
 
     glBindVertexArray(0);
@@ -661,6 +744,7 @@ void CleanUp()
         glDeleteVertexArrays(1, &mesh[i].VAO);
         glDeleteBuffers(1, &mesh[i].VBO);
         glDeleteBuffers(1, &mesh[i].IBO);
+        glDeleteBuffers(1, &mesh[i].HeatMapVBO);
     }
 
     glDeleteTextures(ImageID::NUM_IMAGES, texID);
@@ -742,17 +826,143 @@ void RenderObj(const Object &obj, bool wireframe = false)
 
 
 
-void RenderMeshObj(const Mesh &obj, bool wireframe)
+/******************************************************************************/
+/*!
+\fn     void DrawMeshElements(unsigned drawMode, u32 count, size_t first,
+                              u32 instanceCount)
+\brief
+        Draw a range of the bound index buffer, instanced when instanceCount
+        is not 0.
+*/
+/******************************************************************************/
+static void DrawMeshElements(unsigned drawMode, u32 count, size_t first, u32 instanceCount)
+{
+	if (instanceCount)
+		glDrawElementsInstanced(drawMode, count, GL_UNSIGNED_INT, BUFFER_OFFSET(first * sizeof(GLuint)), instanceCount);
+	else
+		glDrawElements(drawMode, count, GL_UNSIGNED_INT, BUFFER_OFFSET(first * sizeof(GLuint)));
+}
+
+/******************************************************************************/
+/*!
+\fn     void RenderMeshObj(const Mesh &obj, bool wireframe, s32 lod,
+                           u32 instanceCount)
+\brief
+        Render a mesh, or one of its LODs.
+\param  instanceCount
+        0 for a single draw with the mvMat/nmvMat uniforms, otherwise the
+        number of instances from the stream set by BindInstanceStream.
+*/
+/******************************************************************************/
+void RenderMeshObj(const Mesh &obj, bool wireframe, s32 lod, u32 instanceCount)
 {
 	/*  Tell shader to use obj's VAO for rendering */
 	unsigned drawMode = (wireframe) ? GL_LINES : GL_TRIANGLES;
 	glBindVertexArray(obj.VAO);
-	glDrawElements(drawMode, obj.numIndices, GL_UNSIGNED_INT, nullptr);
+	if (lod >= 0 && lod < (s32)obj.lods.size())
+	{
+		/*  LOD ranges sit after the full index buffer in the same IBO */
+		const MeshPartBufferType &parts = obj.lods[lod].parts;
+		for (size_t i = 0; i < parts.size(); ++i)
+			DrawMeshElements(drawMode, parts[i].indexCount, obj.indexBuffer.size() + parts[i].indexStart, instanceCount);
+		return;
+	}
+	if (obj.parts.empty())
+	{
+		DrawMeshElements(drawMode, obj.numIndices, 0, instanceCount);
+		return;
+	}
+
+	/*  one draw per material range of a multi-part model */
+	for (size_t i = 0; i < obj.parts.size(); ++i)
+		DrawMeshElements(drawMode, obj.parts[i].indexCount, obj.parts[i].indexStart, instanceCount);
+}
+
+/******************************************************************************/
+/*!
+\fn     void BindInstanceStream(const Mesh &obj, GLuint instanceVBO, u32 first)
+\brief
+        Attach an instance buffer to the VAO of the mesh, starting at its
+        first-th instance. GL 3.3 has no base instance, so drawing a later
+        run of instances moves the attribute pointers instead.
+*/
+/******************************************************************************/
+void BindInstanceStream(const Mesh &obj, GLuint instanceVBO, u32 first)
+{
+	glBindVertexArray(obj.VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	for (int i = 0; i < numInstanceAttribs; ++i)
+	{
+		glEnableVertexAttribArray(instanceLayout[i].location);
+		glVertexAttribPointer(  instanceLayout[i].location, instanceLayout[i].size, instanceLayout[i].type,
+		                        instanceLayout[i].normalized, instanceSize, 
+		                        BUFFER_OFFSET(first * instanceSize + instanceLayout[i].offset));
+		glVertexAttribDivisor(instanceLayout[i].location, 1);
+	}
+}
+
+/******************************************************************************/
+/*!
+\fn     void UnbindInstanceStream(const Mesh &obj)
+\brief
+        Detach the instance buffer again, so that plain draws of the same 
+        mesh (debug cubes and spheres) do not read it.
+*/
+/******************************************************************************/
+void UnbindInstanceStream(const Mesh &obj)
+{
+	glBindVertexArray(obj.VAO);
+	for (int i = 0; i < numInstanceAttribs; ++i)
+		glDisableVertexAttribArray(instanceLayout[i].location);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/******************************************************************************/
+/*!
+\fn     s32 SelectMeshLOD(const Mesh &obj, const vec3 &center, f32 radius,
+                          const Mat4 &MVMat)
+\brief
+        Pick the coarsest LOD whose error projects to at most lodPixelError
+        pixels, measured at the nearest point of the model's bounding sphere.
+\param  obj
+        Mesh with its LOD chain.
+\param  center, radius
+        Model space bounding sphere of the mesh.
+\param  MVMat
+        Model-view matrix of the instance.
+\return
+        LOD index, or -1 for the full resolution mesh.
+*/
+/******************************************************************************/
+s32 SelectMeshLOD(const Mesh &obj, const vec3 &center, f32 radius, const Mat4 &MVMat)
+{
+	if (!useLOD || obj.lods.empty())
+		return -1;
+
+	/*  largest axis scale of the model-view transform */
+	f32 scale = 0.f;
+	for (int i = 0; i < 3; ++i)
+		scale = std::max(scale, glm::length(vec3(MVMat[i])));
+
+	vec4 viewCenter = MVMat * vec4(center, 1.f);
+	f32 dist = std::max(glm::length(vec3(viewCenter)) - radius * scale, mainCam.nearPlane);
+
+	/*  pixels covered by one view space unit at that distance */
+	f32 pixelsPerUnit = mainCam.height * mainCam.nearPlane / (2.f * mainCam.topPlane) / dist;
+
+	s32 lod = -1;
+	for (s32 i = 0; i < (s32)obj.lods.size(); ++i)
+	{
+		if (obj.lods[i].error * scale * pixelsPerUnit > lodPixelError)
+			break;
+		lod = i;
+	}
+	return lod;
 }
 
 void RenderMeshObjs()
 {
-    Proto::SceneObjectManager::GetInstance().DrawAll(mainCamViewMat);
+    Proto::SceneObjectManager::GetInstance().DrawAll(mainCamViewMat, mainCamProjMat);
 }
 
 /******************************************************************************/
@@ -810,6 +1020,8 @@ void RenderObjs(	Mat4 MVMat[], Mat4 normalMVMat[])
 void Render()
 {
     Proto::SceneObjectManager& gom = Proto::SceneObjectManager::GetInstance();
+    Proto::HeatMapWorker& heatMapWorker = Proto::HeatMapWorker::GetInstance();
+    u32 allocationsAtStart = Proto::GetAllocationCount();
     clock_t  cTime;
      
     cTime = clock();
@@ -818,8 +1030,7 @@ void Render()
 	elapsedtime += deltaTime;
 
 
-	Proto::SceneObject* pSphere = gom.m_AllActiveObj["sphere"];
-    //@MSMS:TODO for loop recalculating too many things lol
+	Proto::SceneObject* pSphere = gom.GetSceneObject(sphereHandle);
 	
 	if (renderingModeChanged)
 	{
@@ -830,16 +1041,16 @@ void Render()
 			break;
 
 		case ProgType::MAIN_PROG:
-			for (auto it = gom.m_AllActiveObj.begin(); it != gom.m_AllActiveObj.end(); ++it)
+			//the sphere is compared against every other object, both ways
+			activeShaderProgram = ProgType::HEAT_MAP_PROG;
+			heatMapTracker.Clear();
+			for (u32 i = 0; i < gom.GetNumberofSceneObjects(); ++i)
 			{
-				if (it->first == "sphere")
+				if (gom.GetSceneObjectAt(i) == pSphere || pSphere == nullptr)
 					continue;
 
-				Proto::SceneObject* pOther = it->second;
-
-				activeShaderProgram = ProgType::HEAT_MAP_PROG;
-				updateHeatMap(pSphere, pOther);
-				updateHeatMap(pOther, pSphere);
+				heatMapTracker.Track(sphereHandle, gom.GetHandleAt(i));
+				heatMapTracker.Track(gom.GetHandleAt(i), sphereHandle);
 			}
 			break;
 
@@ -859,42 +1070,34 @@ void Render()
     glClearBufferfv(GL_DEPTH, 0, &one);
 
     ComputeMainCamMats();
-    bool hasChanged(activeControlledObject->isMoved());
+    gom.SetBroadphase(broadphaseType);
     gom.UpdateAll(deltaTime);
+    broadphaseMs = gom.GetBroadphaseMs();
+    broadphasePairs = gom.GetBroadphasePairCount();
 
-    //recalculate heatmap when needed
-	//optimization using spatial partitioning required here
-    if (hasChanged && activeControlledObject != &mainCam && activeShaderProgram == ProgType::HEAT_MAP_PROG)
-    {
-		for (auto it = gom.m_AllActiveObj.begin(); it != gom.m_AllActiveObj.end(); ++it)
-		{
-			if (it->first == "sphere")
-				continue;
-
-			Proto::SceneObject* pOther = it->second;
-
-			updateHeatMap(pSphere, pOther);
-			updateHeatMap(pOther, pSphere);
+    //recalculate only the heatmaps whose objects moved or whose tolerance
+    //changed, the results are computed off the render thread and picked
+    //up below once they are done
+    if (activeShaderProgram == ProgType::HEAT_MAP_PROG)
+        heatMapTracker.SubmitInvalidated(heatMapTolerance);
 
+    UpdateLightPosViewFrame();
 
-			//Proto::AABB aabb = pOther->GetMeshRenderer()->GetWorldSpaceAABB();
-			//Proto::BS bs = pSphere->GetMeshRenderer()->GetWorldSpaceBS();
-		}
-    }
-   
-    
-    
-	UpdateLightPosViewFrame();
-
-	SendProjMat(mainCamProjMat, mainProjMatLoc);
+    SendProjMat(mainCamProjMat, mainProjMatLoc);
 
+    heatMapWorker.SetProgressive(progressiveHeatMap, heatMapFrameBudget);
+    Proto::MeshPageCache::GetInstance().SetBudget(u64(pageCacheBudgetMB) << 20);
+    pageCacheResidentMB = f32(Proto::MeshPageCache::GetInstance().GetResidentBytes()) / (1 << 20);
+    heatMapWorker.UploadCompletedResults();
     RenderMeshObjs();
+    instancedDrawCalls = gom.GetInstancedDrawCount();
     
     /*  Reset */
 	mainCam.moved = false;
 	mainCam.resized = false;
 
     EstimateFPS();
+    allocationsPerFrame = Proto::GetAllocationCount() - allocationsAtStart;
     TwDraw();   /*  Update AntTweakBar */
 
     glutSwapBuffers();
@@ -1229,6 +1432,8 @@ void LoadResources()
     c->SetModel("MODEL_DSPHERE");
     gom.AddSceneObject(p_go);
 #endif
+
+    sphereHandle = gom.FindSceneObject("sphere");
 }
 
 void LoadSceneObj(void* vp_go, str sModelName, str sSOInstID,
@@ -1309,132 +1514,4 @@ void TW_CALL ToggleRotateModel(void *)
     boRotateModels = !boRotateModels;
 }
 
-void updateHeatMap(Proto::SceneObject* shadedObject, Proto::SceneObject* opposingObject)
-{
-	if (shadedObject == nullptr || opposingObject == nullptr) return;
-
-	if (!shadedObject->GetMeshRenderer()  || !opposingObject->GetMeshRenderer()) return;
-
-	auto& shadedMeshRenderer	= *shadedObject->GetMeshRenderer();
-	auto& opposingMeshRenderer  = *opposingObject->GetMeshRenderer();
-
-	if (shadedMeshRenderer.GetModel() == nullptr || opposingMeshRenderer.GetModel() == nullptr) return;
-
-	auto& shadedModel   = *shadedMeshRenderer.GetModel();
-	auto& opposingModel = *opposingMeshRenderer.GetModel();
-	auto& shadedMesh	= shadedModel.GetModelMesh();
-	auto& opposingMesh  = opposingModel.GetModelMesh();
-	const auto& shadedObjectMTW	= shadedObject->GetMWMatrix();
-	const auto shadedNormalMTW	= Mat3(Transpose(Inverse(shadedObjectMTW)));
-	//const auto shadedNormalMTW = Mat3(shadedObjectMTW);
-
-	const auto& opposingObjectMTW = opposingObject->GetMWMatrix();
-
-	auto& shadedVertices = shadedMesh.vertexBuffer;
-	auto& opposingVertices = opposingMesh.vertexBuffer;
-
-	u32 total = shadedVertices.size();
-	f32 timeOfIntersection(std::numeric_limits<f32>::max());
-	
-	//for each shaded vertex
-	for (u32 i = 0; i < total; ++i)
-	{
-		auto& shadedVertex = shadedMesh.vertexBuffer[i];
-		//reset heatmap value for vertex
-		shadedVertex.heatmap.x = 0.5f;
-		shadedVertex.heatmap.y = 1.f;
-		//get world space position of vertex and normal direction of shaded vertex
-		Vec3 worldSpacePosition = Vec3(shadedObjectMTW * Vec4(shadedVertex.pos, 1.f));
-		Vec3 worldSpaceNormal = shadedNormalMTW * shadedVertex.nrm;
-		worldSpaceNormal = Normalise(worldSpaceNormal);
-
-		//spatial partioning traversal decision function
-		auto IsInPartition = [worldSpacePosition, worldSpaceNormal](const HierachicalAABBNode& a)->bool
-		{
-			Vec3 intersectionPoint;
-			f32 timeOfIntersection;
-			bool flag = IntersectRayAABB(worldSpacePosition, worldSpaceNormal, a.m_AABB, timeOfIntersection, intersectionPoint);
-			//ray cast in the opposite direction if there is no collision detected
-			if (!flag)
-				flag = IntersectRayAABB(worldSpacePosition, -worldSpaceNormal, a.m_AABB, timeOfIntersection, intersectionPoint);
-			return flag;
-		};
-
-
-		bool hasCollision(false);
-		f32 bestTime(timeOfIntersection);
-		bool isTriangleBehindVertex(false);
-
-		auto Visitor = [&hasCollision, &bestTime, &isTriangleBehindVertex, 
-			&shadedVertex, &opposingVertices, &opposingObjectMTW, 
-			worldSpacePosition, worldSpaceNormal](const HierachicalAABBNode& a)->void
-		{
-			//is in leaf node
-			if (a.m_LeftChild == -1 || a.m_RightChild == -1)
-			{
-				u32 total2 = a.triangleIndices.size();
-				
-
-				for (u32 j = 0; j < total2; ++j)
-				{
-					f32 distance(std::numeric_limits<f32>::max());
-
-					auto& triangle = a.triangleIndices[j];
-					auto v0 = opposingVertices[triangle[0]].pos;
-					auto v1 = opposingVertices[triangle[1]].pos;
-					auto v2 = opposingVertices[triangle[2]].pos;
-
-					v0 = Vec3(opposingObjectMTW * Vec4(v0, 1.f));
-					v1 = Vec3(opposingObjectMTW * Vec4(v1, 1.f));
-					v2 = Vec3(opposingObjectMTW * Vec4(v2, 1.f));
-					
-					if (Proto::IntersectRayTriangle(worldSpacePosition, worldSpaceNormal, v0, v1, v2, distance))
-					{
-						if (bestTime > distance)
-						{
-							bestTime = distance;
-							isTriangleBehindVertex = false;
-							hasCollision = true;
-						}
-					}
-					//check the opposite of the normal direction as well
-					if (Proto::IntersectRayTriangle(worldSpacePosition, -worldSpaceNormal, v0, v1, v2, distance))
-					{
-						if (bestTime > distance)
-						{
-							bestTime = distance;
-							isTriangleBehindVertex = true;
-							hasCollision = true;
-						}
-					}
-				}
-
-			}
-		};
-
-		
-		opposingMeshRenderer.GetWorldSpaceHAABB().VisitNodes(Visitor, IsInPartition);
-		if (hasCollision)
-		{
-			//rescale value to a range
-			//bestTime *=50;
-			//clamp value
-			bestTime = (bestTime > 0.5f) ? 0.5f : bestTime;
-			//invert value if behind the vertex
-			bestTime = (isTriangleBehindVertex) ? bestTime + 0.5f: 0.5f - bestTime;
-			shadedVertex.heatmap.x = bestTime; 
-			shadedVertex.heatmap.y = 0.f;
-		}
-		else
-		{
-			shadedVertex.heatmap.x = 0.5f;
-			shadedVertex.heatmap.y = 1.f;
-		}
-	}
-	UpdateGPUMesh(shadedMesh);
-}
-
-
-
-
 /*  YAY ! END OF THE SUPER TEDIOUS DOCUMENTATION !!! */
\ No newline at end of file
@@ -32,6 +32,7 @@
 /*  For displaying frame-per-second */
 extern float fps;
 extern GLint mainMVMatLoc, mainNMVMatLoc, mainProjMatLoc, objectColorLoc;  /*  used for main program */
+extern GLint mainViewMatLoc, instancingOnLoc;                             /*  used by instanced draws */
 
 extern size_t windowWidth, windowHeight;
 
@@ -61,8 +62,13 @@ void CleanUp();
 void Resize(int w, int h);
 void Render();
 void ComputeObjMVMat(Mat4& MVMat, Mat4& NMVMat, const Mat4& viewMat, const Mat4& modelMat);
-void RenderMeshObj(const Mesh &obj, bool wireframe = false);
+void RenderMeshObj(const Mesh &obj, bool wireframe = false, s32 lod = -1, u32 instanceCount = 0);
+void BindInstanceStream(const Mesh &obj, GLuint instanceVBO, u32 first);
+void UnbindInstanceStream(const Mesh &obj);
+s32 SelectMeshLOD(const Mesh &obj, const vec3 &center, f32 radius, const Mat4 &MVMat);
 void UpdateGPUMesh(const Mesh &obj);
+void SetUpHeatMapStream(Mesh &mesh);
+void UpdateGPUHeatMap(const Mesh &obj);
 
 void SendMVMat(const Mat4 &mvMat, const Mat4 &nmvMat, GLint mvMatLoc, GLint nmvMatLoc);
 void SendObjectColor(const vec3& color, GLint objectColorLoc);
@@ -91,5 +97,17 @@ void TW_CALL ToggleRotateModel(void *);
 extern u8 u8CurrentBSPDepth;
 extern bool drawBoundingVolumes;
 extern bool boRotateModels;
+extern bool progressiveHeatMap;
+extern f32 heatMapFrameBudget;
+extern f32 heatMapTolerance;
+extern bool useLOD;
+extern f32 lodPixelError;
+extern u32 pageCacheBudgetMB;
+extern f32 pageCacheResidentMB;
+extern u32 allocationsPerFrame;
+extern s32 broadphaseType;
+extern f32 broadphaseMs;
+extern u32 broadphasePairs;
+extern u32 instancedDrawCalls;
 extern const vec3 rotVec;
 #endif
\ No newline at end of file
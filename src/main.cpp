@@ -15,6 +15,8 @@
 #include "graphics.hpp"
 
 #include "DumbSceneGraph.h"
+#include "ModelManager.h"
+#include "IBroadphase.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -95,11 +97,29 @@ void CreateAntTweakBar()
 
     /*  Displaying FPS */
 	TwAddVarRO(myBar, "Frame Rate", TW_TYPE_FLOAT, &fps, ""); 
+#if TRACK_ALLOCATIONS
+	TwAddVarRO(myBar, "Allocations", TW_TYPE_UINT32, &allocationsPerFrame, " label='Allocations/frame' ");
+#endif
 	TwAddButton(myBar, "ToggleHeatMap", ToggleRenderingMode, NULL, " label='Toggle Heat Map' group='' ");
 	TwAddButton(myBar, "ControlCamera", SetControlledObjAsCamera, NULL, " label='Control camera' oup='' ");
 	TwAddButton(myBar, "ControlSceneObject0", SetControlledObjAsSceneObj0, NULL, " label='Control scene obj 0' group='' ");
 	TwAddButton(myBar, "ControlSceneObject1", SetControlledObjAsSceneObj1, NULL, " label='Control scene obj 1' group='' ");
     TwAddButton(myBar, "ControlSceneObject2", SetControlledObjAsSceneObj2, NULL, " label='Control scene bunny' group='' ");
+    TwAddVarRW(myBar, "ProgressiveHeatMap", TW_TYPE_BOOLCPP, &progressiveHeatMap, " label='Progressive' group='Heat_Map' ");
+    TwAddVarRW(myBar, "HeatMapBudget", TW_TYPE_FLOAT, &heatMapFrameBudget, " min=0.5 max=100 step=0.5 label='Budget (ms)' group='Heat_Map' ");
+    TwAddVarRW(myBar, "HeatMapTolerance", TW_TYPE_FLOAT, &heatMapTolerance, " min=0.01 max=10 step=0.01 label='Tolerance' group='Heat_Map' ");
+    TwAddVarRW(myBar, "UseLOD", TW_TYPE_BOOLCPP, &useLOD, " label='Enabled' group='LOD' ");
+    TwAddVarRW(myBar, "LODPixelError", TW_TYPE_FLOAT, &lodPixelError, " min=0.1 max=20 step=0.1 label='Pixel Error' group='LOD' ");
+    TwAddVarRW(myBar, "PageCacheBudget", TW_TYPE_UINT32, &pageCacheBudgetMB, " min=16 max=16384 step=16 label='Budget (MB)' group='Paging' ");
+    TwAddVarRO(myBar, "PageCacheResident", TW_TYPE_FLOAT, &pageCacheResidentMB, " precision=1 label='Resident (MB)' group='Paging' ");
+
+    TwEnumVal broadphases[] = { { Proto::BroadphaseType::SWEEP_AND_PRUNE, "Sweep and prune" },
+                                { Proto::BroadphaseType::SPATIAL_HASH, "Spatial hash" } };
+    TwType broadphaseEnum = TwDefineEnum("BroadphaseType", broadphases, Proto::BroadphaseType::NUM_BROADPHASES);
+    TwAddVarRW(myBar, "Broadphase", broadphaseEnum, &broadphaseType, " label='Type' group='Broadphase' ");
+    TwAddVarRO(myBar, "BroadphaseTime", TW_TYPE_FLOAT, &broadphaseMs, " precision=3 label='Time (ms)' group='Broadphase' ");
+    TwAddVarRO(myBar, "BroadphasePairs", TW_TYPE_UINT32, &broadphasePairs, " label='Pairs' group='Broadphase' ");
+    TwAddVarRO(myBar, "InstancedDraws", TW_TYPE_UINT32, &instancedDrawCalls, " label='Draw calls' group='Rendering' ");
 
     TwAddSeparator(myBar, "misc", "group='Other'");
     TwAddButton(myBar, "ToggleRotateModel", ToggleRotateModel, NULL, " label='Toggle Rotate Model' group='' ");
@@ -158,6 +178,17 @@ void main(int argc, char **argv)
 
     SetUp();
 
+    /*  "-convert" writes the .msb cache of every listed model and exits,
+        later runs then load the caches instead of the source files. */
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "-convert")
+        {
+            Proto::ModelManager::GetInstance().ConvertAllModels("config//ModelFileList.txt");
+            return;
+        }
+    }
+
     CreateAntTweakBar();
     LoadResources();
     /*  The main loop for user drawing and interactions */
@@ -13,6 +13,7 @@
 #endif
 #include "math.hpp"
 #include "mesh.hpp"
+#include "TangentSpace.h"
 #include "Assimp/aiscene.h"        // Output data structure
 #include "Assimp/assimp.hpp"
 #include "Assimp/aipostprocess.h"
@@ -23,7 +24,6 @@
 void BuildIndexBuffer(int stacks, int slices, Mesh &mesh);
 void addVertex(Mesh &mesh, const Vertex &v);
 void addIndex(Mesh &mesh, int index);
-void ComputeTangentsBitangents(VertexBufferType &vertices, const IndexBufferType &indices);
 
 
 /******************************************************************************/
@@ -67,7 +67,8 @@ Mesh CreatePlane(int stacks, int slices)
     }
 
     BuildIndexBuffer(stacks, slices, mesh);
-    ComputeTangentsBitangents(mesh.vertexBuffer, mesh.indexBuffer);
+    Proto::ComputeTangentSpace(mesh, false, true);
+    mesh.UpdateCPUStreams();
 
     return mesh;
 }
@@ -150,12 +151,13 @@ Mesh CreateCube(int length, int height, int width)
         numIndices += planeMesh[planeIndex].numVertices;
     }
 
-    ComputeTangentsBitangents(mesh.vertexBuffer, mesh.indexBuffer);
+    Proto::ComputeTangentSpace(mesh, false, true);
 
     /*  Compute the number of vertices, indices and triangles */
     mesh.numVertices = mesh.vertexBuffer.size();
     mesh.numIndices = mesh.indexBuffer.size();
     mesh.numTris = mesh.numIndices / 3;
+    mesh.UpdateCPUStreams();
 
     mesh.enMT = MTCube;
 
@@ -211,7 +213,8 @@ Mesh CreateSphere(int stacks, int slices)
     }
 
     BuildIndexBuffer(stacks, slices, mesh);
-    ComputeTangentsBitangents(mesh.vertexBuffer, mesh.indexBuffer);
+    Proto::ComputeTangentSpace(mesh, false, true);
+    mesh.UpdateCPUStreams();
 
     mesh.enMT = MTSphere;
 
@@ -318,83 +321,6 @@ void addIndex(Mesh &mesh, int index)
 }
 
 
-/******************************************************************************/
-/*!
-\fn     void ComputeTangentsBitangents(VertexBufferType &vertices, const IndexBufferType &indices)
-\brief
-        Compute the tangent and bitangent at each vertex of the mesh
-\param  vertices
-        The vertex list of the mesh
-\param  indices
-        The index list of the mesh
-*/
-/******************************************************************************/
-void ComputeTangentsBitangents(VertexBufferType &vertices, const IndexBufferType &indices)
-{
-    int numVertices = vertices.size();
-    int numIndices = indices.size();
-
-    int *AverageCounter = new int[numVertices];
-
-    std::memset(AverageCounter, 0, numVertices*sizeof(int));
-
-    for (int index = 0; index < numIndices; index += 3)
-    {
-        int p0 = indices[index + 0];
-        int p1 = indices[index + 1];
-        int p2 = indices[index + 2];
-
-        Vertex &A = vertices[p0];
-        Vertex &B = vertices[p1];
-        Vertex &C = vertices[p2];
-
-        // Get our two vectors across the triangles
-        Vec3 P = B.pos - A.pos;
-        Vec3 Q = C.pos - A.pos;
-
-        // Get our texture components of those vectors
-        Vec2 Puv = B.uv - A.uv;
-        Vec2 Quv = C.uv - A.uv;
-
-        float texCoord = Puv.x * Quv.y - Quv.x * Puv.y;
-
-        // This would handle the case of a small (possibly zero)
-        // reciprocal, just skip this vertex, Tan and Bin aren't incremented
-        // and the counter isn't incremented.
-        if (texCoord < EPSILON && texCoord > -EPSILON)
-            continue;
-
-        float reciprocal = 1.0f / texCoord;
-
-        Vec3 Tangent((P * Quv.y - Q * Puv.y) * reciprocal);
-        Vec3 Bitangent((Q * Puv.x - P * Quv.x) * reciprocal);
-
-        A.tan += Tangent;
-        B.tan += Tangent;
-        C.tan += Tangent;
-
-        A.bitan += Bitangent;
-        B.bitan += Bitangent;
-        C.bitan += Bitangent;
-
-        ++AverageCounter[p0];
-        ++AverageCounter[p1];
-        ++AverageCounter[p2];
-    }
-
-    // For each vertex, divide by the number of triangles shared by it
-    for (int vert = 0; vert < numVertices; ++vert)
-    {
-        if (AverageCounter[vert])
-        {
-            vertices[vert].tan /= static_cast<float>(AverageCounter[vert]);
-            vertices[vert].bitan /= static_cast<float>(AverageCounter[vert]);
-        }
-    }
-
-    delete[] AverageCounter;
-}
-
 //@MSMS:TODO http://ogldev.atspace.co.uk/www/tutorial22/tutorial22.html
 bool Mesh::LoadModelFromFile(const str & path)
 {	
@@ -435,6 +361,31 @@ void Mesh::UpdateGPUVertexBuffer()
 	glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBuffer.size() * sizeof(vertexBuffer[0]), &vertexBuffer[0]);
 	//glBufferData(GL_ARRAY_BUFFER, vertexBuffer.size() * sizeof(vertexBuffer[0]), &vertexBuffer[0], GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// whatever was sent to the GPU is what the CPU queries should see
+	UpdateCPUStreams();
+}
+
+/******************************************************************************/
+/*!
+\fn     void Mesh::UpdateCPUStreams()
+\brief
+        Refresh positionBuffer and normalBuffer from vertexBuffer.
+        Must be called whenever the positions or normals in vertexBuffer
+        change.
+*/
+/******************************************************************************/
+void Mesh::UpdateCPUStreams()
+{
+    int total = vertexBuffer.size();
+    positionBuffer.resize(total);
+    normalBuffer.resize(total);
+
+    for (int i = 0; i < total; ++i)
+    {
+        positionBuffer[i] = vertexBuffer[i].pos;
+        normalBuffer[i] = vertexBuffer[i].nrm;
+    }
 }
 
 //@MSMS:TODO
@@ -21,19 +21,18 @@
 struct aiMesh;
 struct Vertex
 {
-    Vertex(Vec3 pos, Vec3 nrm, Vec3 tan, Vec3 bitan, Vec2 uv, vec2 heatmap = Vec2(0,0)) 
+    Vertex(Vec3 pos, Vec3 nrm, Vec3 tan, Vec3 bitan, Vec2 uv) 
 		: pos(pos)
 		, nrm(nrm)
 		, tan(tan)
 		, bitan(bitan)
 		, uv(uv)
-		, heatmap(heatmap)
 	{}
 
-	Vertex() : pos(Vec3()), nrm(Vec3()), tan(Vec3()), bitan(Vec3()), uv(Vec2()), heatmap(Vec2(0,0)) { }
+	Vertex() : pos(Vec3()), nrm(Vec3()), tan(Vec3()), bitan(Vec3()), uv(Vec2()) { }
 
     Vec3 pos, nrm, tan, bitan;
-    Vec2 uv, heatmap;
+    Vec2 uv;
 };
 
 const int vertexSize = sizeof(Vertex);
@@ -59,16 +58,67 @@ const VertexLayout vLayout[] =
     { 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, nrm) },
     { 2, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, tan) },
     { 3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, bitan)},
-    { 4, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv) },
-	{ 5, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, heatmap) }
+    { 4, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv) }
 };
 
 const int layoutSize = sizeof(VertexLayout);
 const int numAttribs = sizeof(vLayout) / layoutSize;
 
+/*  The heatmap value lives in its own tightly packed stream so that 
+    recomputing it only re-sends 8 bytes per vertex to the GPU.
+    x : signed distance to the opposing surface, y : 1 if no surface was found */
+typedef Vec2 HeatMapValue;
+const int heatmapSize = sizeof(HeatMapValue);
+const VertexLayout heatmapLayout = { 5, 2, GL_FLOAT, GL_FALSE, 0 };
+
+/*  Per instance stream of instanced draws, advanced once per instance.
+    The model matrix takes locations 6 - 9 and its inverse transpose
+    10 - 12, one column per location. */
+struct InstanceData
+{
+    Mat4 modelMat;
+    Vec3 normalMat[3];
+    Vec3 color;
+};
+
+const int instanceSize = sizeof(InstanceData);
+const VertexLayout instanceLayout[] =
+{
+    { 6,  4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, modelMat) },
+    { 7,  4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, modelMat) + 1 * sizeof(Vec4) },
+    { 8,  4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, modelMat) + 2 * sizeof(Vec4) },
+    { 9,  4, GL_FLOAT, GL_FALSE, offsetof(InstanceData, modelMat) + 3 * sizeof(Vec4) },
+    { 10, 3, GL_FLOAT, GL_FALSE, offsetof(InstanceData, normalMat) },
+    { 11, 3, GL_FLOAT, GL_FALSE, offsetof(InstanceData, normalMat) + 1 * sizeof(Vec3) },
+    { 12, 3, GL_FLOAT, GL_FALSE, offsetof(InstanceData, normalMat) + 2 * sizeof(Vec3) },
+    { 13, 3, GL_FLOAT, GL_FALSE, offsetof(InstanceData, color) }
+};
+const int numInstanceAttribs = sizeof(instanceLayout) / layoutSize;
+
 
 typedef std::vector<Vertex> VertexBufferType;
+typedef std::vector<Vec3> PositionBufferType;
 typedef std::vector<int> IndexBufferType;
+typedef std::vector<HeatMapValue> HeatMapBufferType;
+
+/*  Draw range of one material of a multi-part model, in indices */
+struct MeshPart
+{
+    u32 indexStart;
+    u32 indexCount;
+    u32 materialIndex;
+};
+typedef std::vector<MeshPart> MeshPartBufferType;
+
+/*  One simplified level of a mesh. It reuses the full resolution vertices,
+    so a level is only a set of draw ranges into Mesh::lodIndexBuffer. */
+struct MeshLOD
+{
+    MeshPartBufferType parts;
+    float error;                    /*  object-space distance to the full mesh */
+    std::vector<u32> vertexRemap;   /*  full resolution vertex -> vertex standing in for it */
+};
+typedef std::vector<MeshLOD> MeshLODBufferType;
 
 /*  Mesh format, only contains geometric data but not color/texture */
 struct Mesh
@@ -77,6 +127,7 @@ struct Mesh
 		: numVertices(0)
 		, numTris(0)
 		, numIndices(0)
+		, HeatMapVBO(0)
     {
         vertexBuffer.clear(); 
         indexBuffer.clear();
@@ -87,6 +138,21 @@ struct Mesh
     /*  Storing the actual vertex/index data */
     VertexBufferType vertexBuffer;
     IndexBufferType indexBuffer;
+    HeatMapBufferType heatmapBuffer;
+
+    /*  Draw ranges into indexBuffer, one per material. Empty means a single
+        range over the whole buffer. */
+    MeshPartBufferType parts;
+
+    /*  Simplified levels, coarser with every entry. Their indices follow 
+        indexBuffer in the IBO. */
+    MeshLODBufferType lods;
+    IndexBufferType lodIndexBuffer;
+
+    /*  Tightly packed copies of vertexBuffer[i].pos and .nrm for the CPU side 
+        geometry queries (bounding volumes, heatmap), see UpdateCPUStreams */
+    PositionBufferType positionBuffer;
+    PositionBufferType normalBuffer;
 
     int numVertices;
     int numTris;
@@ -100,12 +166,14 @@ struct Mesh
     GLuint VAO;
     GLuint VBO;
     GLuint IBO;
+    GLuint HeatMapVBO;  /*  separate, dynamic stream for heatmapBuffer */
 
     //type of mesh
     enMeshType enMT;
 
     bool LoadModelFromFile(const str& path);
 	void UpdateGPUVertexBuffer();
+    void UpdateCPUStreams();
 private:
     void            LoadVertices(const aiMesh * t_Mesh);
     void            LoadNormal(const aiMesh * t_Mesh);